@@ -0,0 +1,65 @@
+/*
+ * FILENAME:	Arena.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Arena.hpp"
+#include "Onchip.h"
+
+#include <stddef.h>
+
+// Allocations are rounded up to whole words
+#define ARENA_ALIGN 4
+
+static SCRATCH unsigned int space[ARENA_SIZE/4];
+static SCRATCH unsigned int top = 0;
+static SCRATCH unsigned int highest = 0;
+
+/*
+ * Give back everything, called at the start of every frame
+ */
+void Arena::reset() {
+	top = 0;
+}
+
+/*
+ * Take word aligned space, returns NULL if the arena is full
+ */
+void* Arena::take(unsigned int bytes) {
+	bytes = (bytes + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	if(bytes > ARENA_SIZE - top)
+		return NULL;
+
+	void* p = (char*)space + top;
+	top += bytes;
+	if(top > highest)
+		highest = top;
+	return p;
+}
+
+/*
+ * Remember how much is taken, to give back later with release
+ */
+unsigned int Arena::mark() {
+	return top;
+}
+
+/*
+ * Give back everything taken since mark was called
+ */
+void Arena::release(unsigned int mark) {
+	if(mark < top)
+		top = mark;
+}
+
+/*
+ * Get the bytes taken now and the most ever taken at once
+ */
+unsigned int Arena::used() {
+	return top;
+}
+
+unsigned int Arena::peak() {
+	return highest;
+}
@@ -0,0 +1,46 @@
+/*
+ * FILENAME:	Arena.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+// Bytes of scratch space shared by the stages of one frame
+#define ARENA_SIZE 3584
+
+/*
+ * Arena namespace, fixed block of scratch space for work that does
+ * not outlive a frame or a command. Space is taken and given back
+ * in stack order, so stages that run one after the other share it.
+ */
+namespace Arena {
+	/*
+	 * Give back everything, called at the start of every frame
+	 */
+	void reset();
+
+	/*
+	 * Take word aligned space, returns NULL if the arena is full
+	 */
+	void* take(unsigned int bytes);
+
+	/*
+	 * Remember how much is taken, to give back later with release
+	 */
+	unsigned int mark();
+
+	/*
+	 * Give back everything taken since mark was called
+	 */
+	void release(unsigned int mark);
+
+	/*
+	 * Get the bytes taken now and the most ever taken at once
+	 */
+	unsigned int used();
+	unsigned int peak();
+}
+
+#endif /* ARENA_HPP */
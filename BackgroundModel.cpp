@@ -0,0 +1,80 @@
+/*
+ * FILENAME:	BackgroundModel.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "BackgroundModel.hpp"
+#include "Camera.hpp"
+#include "Math.hpp"
+#include "Onchip.h"
+
+// Background is stored as fixed point with this many fraction bits
+#define BG_FRACTION 4
+
+// Learning rate of the running average is 1/(1<<BG_LEARN_SHIFT)
+#define BG_LEARN_SHIFT 4
+
+// Smallest difference that can ever count as motion (sensor noise floor)
+#define MOTION_TH_MIN 24
+
+// Running average of each VGA pixel, kept in normal (cached) memory
+static SCRATCH unsigned short model[VGA_ROWS][VGA_COLUMNS];
+
+/*
+ * Constructor, model starts empty and is primed by the first frame
+ */
+BackgroundModel::BackgroundModel() {
+	reset();
+}
+
+/*
+ * Discard the model, the next frame becomes the new background
+ */
+void BackgroundModel::reset() {
+	primed = false;
+}
+
+/*
+ * Update the model and write the foreground (absolute difference)
+ * over the region of the frame in a single pass, returns the
+ * threshold to apply to the foreground
+ */
+HOT unsigned char BackgroundModel::apply(volatile unsigned char* frame, int rowStart, int rowEnd, int colStart, int colEnd) {
+	unsigned char max = 0;
+	unsigned char min = 255;
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		volatile unsigned char* px = frame + (r<<VGA_ROW_SHIFT);
+		unsigned short* bg = model[r];
+
+		for(int c = colStart; c < colEnd; c++) {
+			int in = px[c];
+
+			// first frame only seeds the model
+			if(!primed) {
+				bg[c] = in << BG_FRACTION;
+				px[c] = 0;
+				continue;
+			}
+
+			int avg = bg[c] >> BG_FRACTION;
+			unsigned char diff = in > avg ? in - avg : avg - in;
+
+			// move average toward the new sample
+			bg[c] += ((in << BG_FRACTION) - bg[c]) >> BG_LEARN_SHIFT;
+
+			px[c] = diff;
+			max = diff > max ? diff : max;
+			min = diff < min ? diff : min;
+		}
+	}
+
+	// nothing can exceed the threshold on the priming frame
+	if(!primed) {
+		primed = true;
+		return 255;
+	}
+
+	return Math::max<unsigned char>((max>>1) + (min>>1), MOTION_TH_MIN);
+}
@@ -0,0 +1,40 @@
+/*
+ * FILENAME:	BackgroundModel.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef BACKGROUNDMODEL_HPP
+#define BACKGROUNDMODEL_HPP
+
+/*
+ * BackgroundModel class, keeps a running average of the scene
+ * and replaces a region of the frame with its difference from
+ * that average so only moving objects remain bright
+ */
+class BackgroundModel {
+private:
+	bool primed;
+
+protected:
+
+public:
+	/*
+	 * Constructor, model starts empty and is primed by the first frame
+	 */
+	BackgroundModel();
+
+	/*
+	 * Discard the model, the next frame becomes the new background
+	 */
+	void reset();
+
+	/*
+	 * Update the model and write the foreground (absolute difference)
+	 * over the region of the frame in a single pass, returns the
+	 * threshold to apply to the foreground
+	 */
+	unsigned char apply(volatile unsigned char* frame, int rowStart, int rowEnd, int colStart, int colEnd);
+};
+
+#endif /* BACKGROUNDMODEL_HPP */
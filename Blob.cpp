@@ -0,0 +1,168 @@
+/*
+ * FILENAME:	Blob.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Blob.hpp"
+#include "Camera.hpp"
+#include "Arena.hpp"
+#include "Onchip.h"
+
+#include <stddef.h>
+
+// Work space limits for one frame
+#define MAX_RUNS 256
+#define MAX_LABELS 64
+
+// Smallest group of pixels reported as a blob
+#define BLOB_MIN_PIXELS 6
+
+/*
+ * Run struct, consecutive pixels of one row over the threshold
+ */
+struct Run {
+	unsigned char row;
+	unsigned char start;
+	unsigned char end;
+	unsigned char label;
+};
+
+// Work space of the current frame, taken from the arena
+static SCRATCH Run* runs;
+static SCRATCH unsigned char* parent;
+static SCRATCH Blob* merged;
+
+/*
+ * Follow a label to the label of its whole group
+ */
+static unsigned char root(unsigned char label) {
+	while(parent[label] != label) {
+		parent[label] = parent[parent[label]];
+		label = parent[label];
+	}
+	return label;
+}
+
+/*
+ * Constructor
+ */
+BlobFinder::BlobFinder() { }
+
+/*
+ * Find the blobs in a region of the frame, largest first,
+ * returns the number of blobs written to the list
+ */
+int BlobFinder::find(volatile unsigned char* frame, unsigned char threshold,
+		int rowStart, int rowEnd, int colStart, int colEnd, Blob* blobs, int maxBlobs) {
+	int nRuns = 0;
+	int nLabels = 0;
+	int prevStart = 0;
+	int prevEnd = 0;
+
+	unsigned int mark = Arena::mark();
+	runs = (Run*)Arena::take(MAX_RUNS * sizeof(Run));
+	parent = (unsigned char*)Arena::take(MAX_LABELS);
+	merged = (Blob*)Arena::take(MAX_LABELS * sizeof(Blob));
+	if(merged == NULL) {
+		Arena::release(mark);
+		return 0;
+	}
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		volatile unsigned char* px = frame + (r<<VGA_ROW_SHIFT);
+		int rowRuns = nRuns;
+		int p = prevStart;
+
+		for(int c = colStart; c < colEnd && nRuns < MAX_RUNS; c++) {
+			if(px[c] <= threshold)
+				continue;
+
+			Run* run = &runs[nRuns];
+			run->row = r;
+			run->start = c;
+			while(c < colEnd && px[c] > threshold)
+				c++;
+			run->end = c - 1;
+
+			// merge with every run of the previous row touching this one
+			int label = -1;
+			while(p < prevEnd && runs[p].end + 1 < run->start)
+				p++;
+			for(int q = p; q < prevEnd && runs[q].start <= run->end + 1; q++) {
+				unsigned char other = root(runs[q].label);
+				if(label < 0)
+					label = other;
+				else if(other != label)
+					parent[other] = label;
+			}
+
+			// new group, runs that no longer fit a label are dropped
+			if(label < 0) {
+				if(nLabels == MAX_LABELS)
+					continue;
+				label = nLabels++;
+				parent[label] = label;
+			}
+
+			run->label = label;
+			nRuns++;
+		}
+
+		prevStart = rowRuns;
+		prevEnd = nRuns;
+	}
+
+	// accumulate every run into the root of its group
+	for(int l = 0; l < nLabels; l++)
+		merged[l].count = 0;
+
+	for(int i = 0; i < nRuns; i++) {
+		Run* run = &runs[i];
+		Blob* b = &merged[root(run->label)];
+		int len = run->end - run->start + 1;
+
+		if(b->count == 0) {
+			b->row = 0.0f;
+			b->col = 0.0f;
+			b->ulr = run->row;
+			b->ulc = run->start;
+			b->lrr = run->row;
+			b->lrc = run->end;
+		}
+
+		b->count += len;
+		b->row += (float)(run->row * len);
+		b->col += (float)(len * (run->start + run->end)) / 2.0f;
+		b->ulc = run->start < b->ulc ? run->start : b->ulc;
+		b->lrc = run->end > b->lrc ? run->end : b->lrc;
+		b->lrr = run->row;
+	}
+
+	// keep the largest groups, insertion sorted
+	int n = 0;
+	for(int l = 0; l < nLabels; l++) {
+		Blob* b = &merged[l];
+		if(b->count < BLOB_MIN_PIXELS)
+			continue;
+
+		int i;
+		if(n < maxBlobs)
+			i = n++;
+		else if(b->count > blobs[n-1].count)
+			i = n-1;
+		else
+			continue;
+
+		while(i > 0 && blobs[i-1].count < b->count) {
+			blobs[i] = blobs[i-1];
+			i--;
+		}
+		blobs[i] = *b;
+		blobs[i].row /= (float)b->count;
+		blobs[i].col /= (float)b->count;
+	}
+
+	Arena::release(mark);
+	return n;
+}
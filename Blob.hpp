@@ -0,0 +1,49 @@
+/*
+ * FILENAME:	Blob.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef BLOB_HPP
+#define BLOB_HPP
+
+// Most blobs reported for one frame
+#define MAX_BLOBS 16
+
+/*
+ * Blob struct, one connected group of pixels over the threshold
+ */
+struct Blob {
+	int count;
+	float row;
+	float col;
+	int ulr;
+	int ulc;
+	int lrr;
+	int lrc;
+};
+
+/*
+ * BlobFinder class, labels the connected groups of pixels over
+ * a threshold by merging overlapping runs of consecutive rows
+ */
+class BlobFinder {
+private:
+
+protected:
+
+public:
+	/*
+	 * Constructor
+	 */
+	BlobFinder();
+
+	/*
+	 * Find the blobs in a region of the frame, largest first,
+	 * returns the number of blobs written to the list
+	 */
+	int find(volatile unsigned char* frame, unsigned char threshold,
+			int rowStart, int rowEnd, int colStart, int colEnd, Blob* blobs, int maxBlobs);
+};
+
+#endif /* BLOB_HPP */
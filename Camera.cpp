@@ -6,8 +6,11 @@
 
 #include "Camera.hpp"
 #include "I2C.hpp"
+#include "Pyramid.hpp"
 #include "system.h"
 #include "Math.hpp"
+#include "Onchip.h"
+#include "Clock.hpp"
 
 #include <stdio.h>
 
@@ -26,60 +29,293 @@
 // VGA memory address
 #define VGA_BASE 0x80800000
 
-// VGA memory dimensions
-#define VGA_ROWS 60
-#define VGA_COLUMNS 80
+// COMB register, bit 5 multiplexes U, Y and V onto the 8 bit Y port
+#define CAM_COMB 0x13
+#define COMB_8BIT (1<<5)
+// COMB bit 0 enables the sensor's own exposure control
+#define COMB_AEC (1<<0)
+
+// COMA register, bit 5 enables the sensor's own gain control
+#define CAM_COMA 0x12
+#define COMA_AGC (1<<5)
+
+// Gain (6 bits) and exposure registers
+#define CAM_GAIN 0x00
+#define GAIN_MASK 0x3F
+#define CAM_AEC 0x10
+
+// CLKRC register, PCLK is the input clock divided by (divider+1)*2
+#define CAM_CLKRC 0x11
+#define CLKRC_DEFAULT 0x08
+#define CLKRC_FASTEST 0x00
+#define CLKRC_SLOWEST 0x1F
+
+// Frames each divider must capture without a missed edge
+#define CLK_TEST_FRAMES 2
+// Padding byte of the VGA memory written while counting, as
+// capture writes each pixel but without it showing
+#define CLK_TEST_PIXEL ((0x80000000|VGA_BASE) | (VGA_COLUMNS + 47))
+
+// Longest wait for VSYNC, CPU clock ticks (a frame at the slowest
+// divider is well under a second)
+#define FRAME_TIMEOUT (1000000*CLOCK_TICKS_PER_US)
+
+// Polls of the control port allowed for one line before the sensor
+// counts as stopped, reading the timer would cost more than a PCLK so
+// lines are timed by counting polls: about 5 ms at 4 cycles a poll,
+// several lines even at the slowest divider
+#define POLL_CYCLES 4
+#define LINE_TIMEOUT_US 5000
+#define LINE_SPINS (LINE_TIMEOUT_US*CLOCK_TICKS_PER_US/POLL_CYCLES)
+
+// PCLKs after the last pixel of a line by which HREF must have dropped
+#define LINE_SLACK 2
+
+// Chroma planes of the last YUV frame, kept in normal (cached) memory
+static unsigned char planeU[VGA_ROWS*VGA_COLUMNS];
+static unsigned char planeV[VGA_ROWS*VGA_COLUMNS];
+
+// Downsampled copies of the last frame
+static Pyramid levels;
+
+/*
+ * Wait for PCLK to rise while HREF stays high, bits is left holding
+ * the control port as last read and spins the polls remaining
+ */
+#define WAIT_PCLK(control, bits, spins) \
+	while((((bits) = *(control)) & (CAMCONTROL_PCLK|CAMCONTROL_HREF)) == (CAMCONTROL_PCLK|CAMCONTROL_HREF) && --(spins) > 0); \
+	while((((bits) = *(control)) & (CAMCONTROL_PCLK|CAMCONTROL_HREF)) == CAMCONTROL_HREF && --(spins) > 0)
+
+/*
+ * Wait for HREF to rise, after the first line of a frame VSYNC
+ * rising first means lines were lost and also ends the wait
+ */
+#define WAIT_HREF(control, bits, spins, row) \
+	while((((bits) = *(control)) & ((row) ? (CAMCONTROL_HREF|CAMCONTROL_VSYNC) : CAMCONTROL_HREF)) == 0 && --(spins) > 0)
+
+/*
+ * Wait for VSYNC to start a frame, returns false if the sensor
+ * sends none
+ */
+static bool waitFrame(volatile char* control) {
+	unsigned int start = Clock::now();
+
+	// wait for VSYNC falling edge
+	while((*control & CAMCONTROL_VSYNC) == 0)
+		if(Clock::now() - start > FRAME_TIMEOUT)
+			return false;
+
+	return true;
+}
+
+/*
+ * Check that HREF drops within a few PCLKs of the last pixel
+ * of a line, as it does unless noise added PCLK edges
+ */
+static inline bool lineEnded(volatile char* control, int spins) {
+	register char bits;
+	for(int k = 0; k < LINE_SLACK; k++) {
+		WAIT_PCLK(control, bits, spins);
+		if((bits & CAMCONTROL_HREF) == 0 || spins <= 0)
+			return true;
+	}
+
+	return false;
+}
 
 /*
 * Constructor, initializes pointers and I2C component
 */
-Camera::Camera() {
-	i2c = new I2C((char)CAM_SLA);
+Camera::Camera() : i2c((char)CAM_SLA) {
+	pyramid = &levels;
+	mode = CAPTURE_GREY;
+	frameMin = 0;
+	frameMax = 255;
+	divider = CLKRC_DEFAULT;
+	syncTime = 0;
+	period = 0;
 }
 
 /*
  * Get one frame and print it to the VGA memory
  * Parameter debug toggles printing of I2C debug information
+ * Returns why the frame was abandoned, if it was, every wait on
+ * the sensor is bounded and a bad frame ends at once
  */
-unsigned char Camera::getFrame(bool debug) {
+HOT FrameStatus Camera::getFrame(bool debug) {
+	if(mode == CAPTURE_YUV)
+		return getChromaFrame();
+
 	volatile register char* pxlPort = (volatile char*)(0x80000000 | PIXEL_PORT_BASE);
 	volatile register char* control = (volatile char*)(0x80000000 | CAM_CONTROL_BASE);
 
 	register unsigned char min = 255;
 	register unsigned char max = 0;
 	register unsigned char px;
+	register char bits;
+	register int spins;
 
 	// initialize VGA counters
 	register bool rowvalid = false;
 	register unsigned char* vga = (unsigned char*)((0x80000000|VGA_BASE) | (59*(1<<7)) | (79) + 48);
 
+	// initialize pyramid accumulators
+	register unsigned short* sums;
+	register unsigned char pair = 0;
+	pyramid->begin();
 
-	// wait for VSYNC falling edge
-	while((*control & CAMCONTROL_VSYNC) == 0);
-	//while((*control & CAMCONTROL_VSYNC) != 0);
+	// a frame abandoned part way resumes here, at the next VSYNC
+	if(!waitFrame(control))
+		return FRAME_NO_VSYNC;
+	syncTime = Clock::now();
 
 	for(register int r=0; r<CAM_ROWS; r++) {
+		spins = LINE_SPINS;
 		// poll for HREF falling edge
-		while((*control & CAMCONTROL_HREF) != 0);
+		while((*control & CAMCONTROL_HREF) != 0 && --spins > 0);
 		// wait for HREF rising edge
-		while((*control & CAMCONTROL_HREF) == 0);
+		WAIT_HREF(control, bits, spins, r);
+		if(spins <= 0)
+			return FRAME_NO_HREF;
+		if((bits & CAMCONTROL_HREF) == 0)
+			return FRAME_SHORT_FRAME;
 
-		for(register int c=0; c<CAM_COLUMNS;c++) {
-			// wait for pclk rising edge
-			while((*control & CAMCONTROL_PCLK) != 0);
-			while((*control & CAMCONTROL_PCLK) == 0);
+		if(rowvalid) {
+			sums = pyramid->lineSums();
 
+			for(register int c=0; c<CAM_COLUMNS;c++) {
+				// wait for pclk rising edge
+				WAIT_PCLK(control, bits, spins);
+				if(spins <= 0)
+					return FRAME_NO_PCLK;
+				if((bits & CAMCONTROL_HREF) == 0)
+					return FRAME_SHORT_LINE;
 
+				// if valid column, sample data and write to VGA memory
+				if((c >= 8) && ((c&1) == 0) && (c <= 167 )) {
+					px = *pxlPort;
+					min = px<min ? px:min;
+					max = px>max ? px:max;
 
-			// if valid column and row, sample data and write to VGA memory
-			if((c >= 8) && ((c&1) == 0) && (c <= 167 ) && rowvalid) {
-				px = *pxlPort;
-				min = px<min ? px:min;
-				max = px>max ? px:max;
+					*vga = px;
+					vga--;
+
+					// add each horizontal pair of pixels to the pyramid
+					if((c&2) == 0)
+						pair = px;
+					else
+						*(sums++) += pair + px;
+				}
+			}
+
+			if(!lineEnded(control, spins))
+				return FRAME_LONG_LINE;
+		} else if(r > 12) {
+			// this line is not sampled, spend it building the
+			// pyramid from the previous line then wait it out
+			pyramid->finishLine();
+		}
+		// reset VGA column counter
+		rowvalid = false;
+		// if valid row, flag a boolean as such
+		if((r >= 12) && ((r&1) == 0) && (r <= 131)) {
+			rowvalid = true;
+			vga -= 48;
+		}
+	}
+
+	frameMin = min;
+	frameMax = max;
+	return FRAME_OK;
+}
+
+/*
+ * Get one frame with the sensor multiplexing U, Y and V on the
+ * pixel port, Y goes to the VGA memory and U and V to their planes
+ */
+HOT FrameStatus Camera::getChromaFrame() {
+	volatile register char* pxlPort = (volatile char*)(0x80000000 | PIXEL_PORT_BASE);
+	volatile register char* control = (volatile char*)(0x80000000 | CAM_CONTROL_BASE);
+
+	register unsigned char min = 255;
+	register unsigned char max = 0;
+	register unsigned char px;
+	register unsigned char u = 0;
+	register char bits;
+	register int spins;
+
+	// initialize VGA and plane counters
+	register bool rowvalid = false;
+	register unsigned char* vga = (unsigned char*)((0x80000000|VGA_BASE) | (59*(1<<7)) | (79) + 48);
+	register unsigned char* pu = planeU + VGA_ROWS*VGA_COLUMNS - 1;
+	register unsigned char* pv = planeV + VGA_ROWS*VGA_COLUMNS - 1;
+
+	// initialize pyramid accumulators
+	register unsigned short* sums;
+	register unsigned char pair = 0;
+	register bool odd = false;
+	pyramid->begin();
 
-				*vga = px;
-				vga--;
+	// a frame abandoned part way resumes here, at the next VSYNC
+	if(!waitFrame(control))
+		return FRAME_NO_VSYNC;
+	syncTime = Clock::now();
+
+	for(register int r=0; r<CAM_ROWS; r++) {
+		spins = LINE_SPINS;
+		// poll for HREF falling edge
+		while((*control & CAMCONTROL_HREF) != 0 && --spins > 0);
+		// wait for HREF rising edge
+		WAIT_HREF(control, bits, spins, r);
+		if(spins <= 0)
+			return FRAME_NO_HREF;
+		if((bits & CAMCONTROL_HREF) == 0)
+			return FRAME_SHORT_FRAME;
+
+		if(rowvalid) {
+			sums = pyramid->lineSums();
+
+			// each pair of sensor pixels arrives as U Y V Y
+			for(register int b=0; b<2*CAM_COLUMNS; b++) {
+				// wait for pclk rising edge
+				WAIT_PCLK(control, bits, spins);
+				if(spins <= 0)
+					return FRAME_NO_PCLK;
+				if((bits & CAMCONTROL_HREF) == 0)
+					return FRAME_SHORT_LINE;
+
+				// same sensor columns as the grey frame, one output pixel per pair
+				if((b >= 16) && (b <= 335)) {
+					switch(b&3) {
+					case 0:
+						u = *pxlPort;
+						break;
+					case 1:
+						px = *pxlPort;
+						min = px<min ? px:min;
+						max = px>max ? px:max;
+
+						*vga = px;
+						vga--;
+						*(pu--) = u;
+
+						if(!odd)
+							pair = px;
+						else
+							*(sums++) += pair + px;
+						odd = !odd;
+						break;
+					case 2:
+						*(pv--) = *pxlPort;
+						break;
+					}
+				}
 			}
+
+			if(!lineEnded(control, spins))
+				return FRAME_LONG_LINE;
+		} else if(r > 12) {
+			pyramid->finishLine();
 		}
 		// reset VGA column counter
 		rowvalid = false;
@@ -90,7 +326,219 @@ unsigned char Camera::getFrame(bool debug) {
 		}
 	}
 
-	return (min>>1) + (max>>1);
+	frameMin = min;
+	frameMax = max;
+	return FRAME_OK;
+}
+
+/*
+ * Configure the sensor output format for a capture mode
+ */
+void Camera::setCaptureMode(CaptureMode mode) {
+	unsigned char comb = camRead(CAM_COMB);
+	if(mode == CAPTURE_YUV)
+		comb |= COMB_8BIT;
+	else
+		comb &= ~COMB_8BIT;
+	camWrite(CAM_COMB, comb);
+
+	this->mode = mode;
+}
+
+/*
+ * Set the PCLK divider, larger values are slower
+ */
+void Camera::setDivider(unsigned char divider) {
+	camWrite(CAM_CLKRC, divider);
+	this->divider = divider;
+}
+
+/*
+ * Get the PCLK divider in use
+ */
+unsigned char Camera::getDivider() {
+	return divider;
+}
+
+/*
+ * Step the PCLK divider one setting slower, returns false if it
+ * is already the slowest
+ */
+bool Camera::slowDivider() {
+	if(divider >= CLKRC_SLOWEST)
+		return false;
+	setDivider(divider + 1);
+	return true;
+}
+
+/*
+ * Count the PCLK edges the polling loop sees on every line of a
+ * number of frames, returns the number of lines missing some,
+ * or -1 if the sensor stops sending frames. Each edge costs the
+ * loop a pixel read, a compare and a VGA store on top of the
+ * polling capture does, so a setting that passes here leaves
+ * capture some margin.
+ */
+HOT int Camera::lineTest(int frames) {
+	volatile register char* pxlPort = (volatile char*)(0x80000000 | PIXEL_PORT_BASE);
+	volatile register char* control = (volatile char*)(0x80000000 | CAM_CONTROL_BASE);
+	volatile register unsigned char* vga = (volatile unsigned char*)CLK_TEST_PIXEL;
+	register const int expected = (mode == CAPTURE_YUV) ? 2*CAM_COLUMNS : CAM_COLUMNS;
+	register unsigned char px;
+	register unsigned char max = 0;
+	register char c;
+	int incomplete = 0;
+
+	for(int f = 0; f < frames; f++) {
+		if(!waitFrame(control))
+			return -1;
+
+		for(int r = 0; r < CAM_ROWS; r++) {
+			register int spins = LINE_SPINS;
+			while((*control & CAMCONTROL_HREF) != 0 && --spins > 0);
+			while((*control & CAMCONTROL_HREF) == 0 && --spins > 0);
+
+			// count rising edges of PCLK for as long as HREF stays high
+			register int edges = 0;
+			while(spins > 0) {
+				WAIT_PCLK(control, c, spins);
+				if((c & CAMCONTROL_HREF) == 0 || spins <= 0)
+					break;
+				edges++;
+
+				px = *pxlPort;
+				max = px>max ? px:max;
+				*vga = max;
+			}
+
+			if(spins <= 0)
+				return -1;
+			if(edges != expected)
+				incomplete++;
+		}
+	}
+
+	return incomplete;
+}
+
+/*
+ * Step the PCLK divider from the fastest setting and keep the first
+ * one every line is captured completely at, returns false (and
+ * restores the default) if none is or the sensor is silent
+ */
+bool Camera::selectDivider() {
+	for(int d = CLKRC_FASTEST; d <= CLKRC_SLOWEST; d++) {
+		setDivider(d);
+
+		// the frame in progress when the clock changed is discarded
+		if(lineTest(1) < 0)
+			break;
+		int incomplete = lineTest(CLK_TEST_FRAMES);
+		if(incomplete == 0)
+			return true;
+		if(incomplete < 0)
+			break;
+	}
+
+	setDivider(CLKRC_DEFAULT);
+	return false;
+}
+
+/*
+ * Get the average time taken by a number of captures, CPU clock
+ * ticks per frame, and keep it as the frame period
+ */
+unsigned int Camera::frameTime(int frames) {
+	// start timing at a frame boundary
+	getFrame(false);
+
+	unsigned int start = Clock::now();
+	for(int f = 0; f < frames; f++)
+		getFrame(false);
+
+	period = (Clock::now() - start) / frames;
+	return period;
+}
+
+/*
+ * Get when the last frame started (its VSYNC was seen) and the
+ * frame period last measured by frameTime, CPU clock ticks
+ */
+unsigned int Camera::getSyncTime() {
+	return syncTime;
+}
+
+unsigned int Camera::getFramePeriod() {
+	return period;
+}
+
+/*
+ * Let the sensor control its own exposure and gain, or hold
+ * them at the values last written
+ */
+void Camera::setSensorExposure(bool automatic) {
+	unsigned char coma = camRead(CAM_COMA);
+	unsigned char comb = camRead(CAM_COMB);
+	if(automatic) {
+		coma |= COMA_AGC;
+		comb |= COMB_AEC;
+	} else {
+		coma &= ~COMA_AGC;
+		comb &= ~COMB_AEC;
+	}
+	camWrite(CAM_COMA, coma);
+	camWrite(CAM_COMB, comb);
+}
+
+/*
+ * Read the exposure and gain the sensor is using
+ */
+void Camera::getExposure(unsigned char* aec, unsigned char* gain) {
+	*aec = camRead(CAM_AEC);
+	*gain = camRead(CAM_GAIN) & GAIN_MASK;
+}
+
+/*
+ * Write the exposure and gain, which take effect from the next frame
+ */
+void Camera::setExposure(unsigned char aec, unsigned char gain) {
+	camWrite(CAM_AEC, aec);
+	camWrite(CAM_GAIN, gain & GAIN_MASK);
+}
+
+/*
+ * Get the U or V plane of the last YUV frame, stored like the
+ * VGA memory but with rows VGA_COLUMNS bytes apart
+ */
+unsigned char* Camera::uPlane() {
+	return planeU;
+}
+
+unsigned char* Camera::vPlane() {
+	return planeV;
+}
+
+/*
+ * Get the threshold halfway between the darkest and brightest
+ * pixels of the last frame captured
+ */
+unsigned char Camera::getThreshold() {
+	return (frameMin>>1) + (frameMax>>1);
+}
+
+/*
+ * Get the darkest and brightest pixels of the last frame captured
+ */
+void Camera::getRange(unsigned char* min, unsigned char* max) {
+	*min = frameMin;
+	*max = frameMax;
+}
+
+/*
+ * Get the downsampled copies of the last frame captured
+ */
+Pyramid* Camera::getPyramid() {
+	return pyramid;
 }
 
 /*
@@ -99,7 +547,7 @@ unsigned char Camera::getFrame(bool debug) {
 volatile unsigned char* Camera::pixel(int row, int column) {
 	row = Math::clamp(row, 0, VGA_ROWS-1);
 	column = Math::clamp(column, 0, VGA_COLUMNS-1);
-	volatile unsigned char* rv = (volatile unsigned char*)(VGA_BASE|row<<7|column);
+	volatile unsigned char* rv = (volatile unsigned char*)(VGA_BASE|row<<VGA_ROW_SHIFT|column);
 	return rv;
 }
 
@@ -108,8 +556,8 @@ volatile unsigned char* Camera::pixel(int row, int column) {
  */
 unsigned char Camera::camRead(unsigned char subaddr) {
 	unsigned char rv = '\0';
-	if(i2c->transfer(false, &subaddr, true, true))
-		i2c->transfer(true, &rv, true, true);
+	if(i2c.transfer(false, &subaddr, true, true))
+		i2c.transfer(true, &rv, true, true);
 	return rv;
 }
 
@@ -117,6 +565,6 @@ unsigned char Camera::camRead(unsigned char subaddr) {
  * write data to the camera register specified by subaddr
  */
 void Camera::camWrite(unsigned char subaddr, unsigned char data) {
-	if(i2c->transfer(false, &subaddr, false, true))
-		i2c->transfer(false, &data, true, false);
+	if(i2c.transfer(false, &subaddr, false, true))
+		i2c.transfer(false, &data, true, false);
 }
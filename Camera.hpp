@@ -8,6 +8,17 @@
 #define CAMERA_HPP_
 
 #include "I2C.hpp"
+#include "CaptureMode.h"
+#include "FrameStatus.h"
+
+// VGA memory dimensions
+#define VGA_ROWS 60
+#define VGA_COLUMNS 80
+
+// Each VGA row occupies 1<<VGA_ROW_SHIFT bytes of memory
+#define VGA_ROW_SHIFT 7
+
+class Pyramid;
 
 /*
  * Camera class definition
@@ -15,7 +26,20 @@
  */
 class Camera {
 private:
-	I2C* i2c;
+	I2C i2c;
+	Pyramid* pyramid;
+	CaptureMode mode;
+	unsigned char frameMin;
+	unsigned char frameMax;
+	unsigned char divider;
+	unsigned int syncTime;
+	unsigned int period;
+
+	/*
+	 * Get one frame with the sensor multiplexing U, Y and V on the
+	 * pixel port, Y goes to the VGA memory and U and V to their planes
+	 */
+	FrameStatus getChromaFrame();
 protected:
 
 public:
@@ -27,8 +51,97 @@ public:
 	/*
 	 * Get one frame and print it to the VGA memory
 	 * Parameter debug toggles printing of I2C debug information
+	 * Returns why the frame was abandoned, if it was, every wait on
+	 * the sensor is bounded and a bad frame ends at once
+	 */
+	FrameStatus getFrame(bool debug);
+
+	/*
+	 * Get the threshold halfway between the darkest and brightest
+	 * pixels of the last frame captured
+	 */
+	unsigned char getThreshold();
+
+	/*
+	 * Get the darkest and brightest pixels of the last frame captured
+	 */
+	void getRange(unsigned char* min, unsigned char* max);
+
+	/*
+	 * Get the downsampled copies of the last frame captured
+	 */
+	Pyramid* getPyramid();
+
+	/*
+	 * Configure the sensor output format for a capture mode
+	 */
+	void setCaptureMode(CaptureMode mode);
+
+	/*
+	 * Set the PCLK divider, larger values are slower
+	 */
+	void setDivider(unsigned char divider);
+
+	/*
+	 * Get the PCLK divider in use
+	 */
+	unsigned char getDivider();
+
+	/*
+	 * Step the PCLK divider one setting slower, returns false if it
+	 * is already the slowest
+	 */
+	bool slowDivider();
+
+	/*
+	 * Count the PCLK edges the polling loop sees on every line of a
+	 * number of frames, returns the number of lines missing some,
+	 * or -1 if the sensor stops sending frames
+	 */
+	int lineTest(int frames);
+
+	/*
+	 * Step the PCLK divider from the fastest setting and keep the first
+	 * one every line is captured completely at, returns false (and
+	 * restores the default) if none is or the sensor is silent
+	 */
+	bool selectDivider();
+
+	/*
+	 * Get the average time taken by a number of captures, CPU clock
+	 * ticks per frame, and keep it as the frame period
+	 */
+	unsigned int frameTime(int frames);
+
+	/*
+	 * Get when the last frame started (its VSYNC was seen) and the
+	 * frame period last measured by frameTime, CPU clock ticks
+	 */
+	unsigned int getSyncTime();
+	unsigned int getFramePeriod();
+
+	/*
+	 * Let the sensor control its own exposure and gain, or hold
+	 * them at the values last written
+	 */
+	void setSensorExposure(bool automatic);
+
+	/*
+	 * Read the exposure and gain the sensor is using
+	 */
+	void getExposure(unsigned char* aec, unsigned char* gain);
+
+	/*
+	 * Write the exposure and gain, which take effect from the next frame
+	 */
+	void setExposure(unsigned char aec, unsigned char gain);
+
+	/*
+	 * Get the U or V plane of the last YUV frame, stored like the
+	 * VGA memory but with rows VGA_COLUMNS bytes apart
 	 */
-	unsigned char getFrame(bool debug);
+	unsigned char* uPlane();
+	unsigned char* vPlane();
 
 	/*
 	 * Get a pointer to the pixel data at a specified location
@@ -5,196 +5,523 @@
  */
 
 #include "CameraMount.hpp"
-#include "Servo.hpp"
-#include "PWMIndex.h"
+#include "MotionEngine.hpp"
 #include "Math.hpp"
+#include "Pyramid.hpp"
+#include "Clock.hpp"
+#include "Arena.hpp"
 
 #include <stdio.h>
 #include <unistd.h>
 
-// Tilt servo boundaries
-#define TILT_MIN 0.02f
-#define TILT_MAX 0.10f
-
-// Pan servo boundaries
-#define PAN_MIN 0.025f
-#define PAN_MAX 0.12f
-
-// Servo input boundaries
-#define INPUT_MIN 0.0f
-#define INPUT_MAX 1.0f
-
-// Initial servo positions
-#define PAN_INIT 0.5f
-#define TILT_INIT 0.6f
-
-#define ADJ_FACTOR_PAN (-0.5f)
-#define ADJ_FACTOR_TILT (0.6f)
-#define PXROW_TH_COLS 5
-#define PXROW_TH_ROWS 3
-
-#define ROW_START 18
-#define ROW_END 55
-#define COL_START 5
-#define COL_END 75
+// Middle of the region of interest
+#define ROW_MID ((params.rowEnd+params.rowStart)/2)
+#define COL_MID ((params.colEnd+params.colStart)/2)
+
+// Frames between checks that the PCLK divider still captures every edge
+#define CLOCK_CHECK_FRAMES 1000
+// Captures timed to report the frame rate
+#define CLOCK_RATE_FRAMES 10
+
+// Captures tried for a usable frame while calibrating
+#define FRAME_RETRIES 3
+
+// Time before a predicted VSYNC from which capture waits for it,
+// microseconds
+#define CAPTURE_MARGIN_US 500
+
+// Servo step taken by each axis while calibrating, degrees
+#define CAL_STEP 5.0f
+// Frames averaged for a position
+#define CAL_AVERAGE 3
+// Most frames waited for a step to settle
+#define CAL_MAX_FRAMES 30
+// Target shift that counts as moving, and as standing still, pixels
+#define CAL_MOVED_PX 1.0f
+#define CAL_STILL_PX 0.5f
+// Smallest shift a step must cause to be measured, pixels
+#define CAL_MIN_SHIFT 2.0f
 
 /*
  * Constructor, Initialize servos and camera, set defaults
  */
-CameraMount::CameraMount() {
-	// init components
-	servoPan = new Servo(PWMINDEX_A, PAN_INIT * (PAN_MIN + PAN_MAX));
-	servoTilt = new Servo(PWMINDEX_B, TILT_INIT * (TILT_MIN + TILT_MAX));
-	camera = new Camera();
-	threshold = 128;
+CameraMount::CameraMount() : mount(&params), tracker(&params, &overlay) {
+	Params::defaults(&params);
+	saved = params;
+
+	clockFrames = 0;
+	framePeriod = 0;
+	exposurePending = false;
+	tracker.begin(camera.pixel(0,0), camera.getPyramid(), camera.uPlane(), camera.vPlane(), 128, &report);
 
 	// set defaults
 	reset();
+	setAutoExposure(true);
+
+	// nothing has moved yet, the mount is where it was first sent
+	mount.placeFrame(mount.getStep(), mount.getStep());
+
+	// servos move toward the positions set from here on
+	MotionEngine::start(mount.getPanServo(), mount.getTiltServo());
 }
 
 /*
  * Set the pan servo to a position specified by degrees
  */
 void CameraMount::pan(float degrees) {
-	float value = Math::scale<float>(degrees, -90.0f, 90.0f, PAN_MIN, PAN_MAX);
-	servoPan->setDC(Math::clamp<float>(value, PAN_MIN, PAN_MAX));
-	lastPan = Math::scale<float>(servoPan->getDC(), PAN_MIN, PAN_MAX, -90.0f, 90.0f);
+	mount.pan(degrees);
 }
 
 /*
  * Set the tilt servo to a position specified by degrees
  */
 void CameraMount::tilt(float degrees) {
-	float value = Math::scale<float>(degrees, 0.0f, 90.0f, 0.0f, 0.65f);
-	servoTilt->setDC(Math::clamp<float>(Math::scale<float>(value, INPUT_MIN, INPUT_MAX, TILT_MIN, TILT_MAX), TILT_MIN, TILT_MAX));
-	lastTilt = Math::scale<float>(servoTilt->getDC(), TILT_MIN, TILT_MAX, INPUT_MIN, INPUT_MAX);
-	lastTilt = Math::scale<float>(lastTilt, 0.0f, 0.65f, 0.0f, 90.0f);
+	mount.tilt(degrees);
 }
 
 /*
  * Write a value to a camera register
  */
 void CameraMount::write(char subaddr, char data) {
-	camera->camWrite(subaddr, data);
+	camera.camWrite(subaddr, data);
 }
 
 /*
  * Read a value from a camera register
  */
 char CameraMount::read(char subaddr) {
-	return camera->camRead(subaddr);
+	return camera.camRead(subaddr);
 }
 
 /*
- * Print a camera frame to the VGA memory
+ * Print a camera frame to the VGA memory, returns why the frame
+ * was abandoned if it was, in which case it must not be used
  */
-void CameraMount::getCameraFrame(bool debug) {
-	threshold = camera->getFrame(debug);
+FrameStatus CameraMount::getCameraFrame(bool debug) {
+	unsigned int last = report.start;
+	report.start = Clock::now();
+	report.found = false;
+	report.hasBox = false;
+	framePeriod = report.start - last;
+	unsigned int from = mount.getStep();
+	Arena::reset();
+	FrameStatus status = camera.getFrame(debug);
+
+	if(status == FRAME_OK) {
+		tracker.begin(camera.pixel(0,0), camera.getPyramid(), camera.uPlane(), camera.vPlane(),
+				camera.getThreshold(), &report);
+		mount.placeFrame(from, mount.getStep());
+
+		// the registers are written by serviceSensor, outside capture
+		unsigned char min, max;
+		camera.getRange(&min, &max);
+		if(exposure.update(camera.getPyramid(), max))
+			exposurePending = true;
+	}
+	report.captured = Clock::now();
+
+	// every so often, and whenever a line comes up short, spend a frame
+	// making sure no PCLK edges are being missed, and slow the clock
+	// down a step if they are
+	if(status == FRAME_SHORT_LINE || ++clockFrames >= CLOCK_CHECK_FRAMES) {
+		clockFrames = 0;
+		if(camera.lineTest(1) > 0 && camera.slowDivider())
+			printf("Missed PCLK edges, camera clock divider now %d\n", camera.getDivider());
+	}
+
+	return status;
 }
 
-void CameraMount::updateThreshold() {
-	unsigned char max = 0;
-	unsigned char min = 255;
-
-	for(int r = ROW_START; r < ROW_END; r++) {
-		for(int c = COL_START; c < COL_END; c++) {
-			unsigned char px = *(camera->pixel(r,c));
-			max = px > max ? px : max;
-			min = px < min ? px : min;
-		}
+/*
+ * Find the fastest PCLK divider the capture loop keeps up with
+ * and report the frame rate it gives
+ */
+bool CameraMount::testClock() {
+	bool found = camera.selectDivider();
+	if(!found)
+		printf("No camera clock divider captured every line\n");
+
+	unsigned int ticks = camera.frameTime(CLOCK_RATE_FRAMES);
+	printf("Camera clock divider %d, %.1f fps\n", camera.getDivider(),
+			(float)CLOCK_TICKS_PER_US*1000000.0f / ticks);
+
+	clockFrames = 0;
+	return found;
+}
+
+/*
+ * Check whether sensor registers are waiting to be written
+ */
+bool CameraMount::sensorPending() {
+	return exposurePending;
+}
+
+/*
+ * Write the sensor registers the last frames asked for
+ */
+void CameraMount::serviceSensor() {
+	if(exposurePending) {
+		camera.setExposure(exposure.getExposure(), exposure.getGain());
+		exposurePending = false;
 	}
+}
 
-	threshold = (max>>1) + (min>>1);
+/*
+ * Get when the next frame capture has to start so its VSYNC is not
+ * missed, predicted from the last frame's VSYNC and the frame period
+ */
+unsigned int CameraMount::frameDue() {
+	unsigned int period = camera.getFramePeriod();
+	unsigned int now = Clock::now();
+	if(period == 0)
+		return now;
+
+	// the first VSYNC still to come
+	unsigned int next = camera.getSyncTime() + period;
+	if((int)(now - next) >= 0)
+		next += ((now - next) / period + 1) * period;
+
+	return next - CAPTURE_MARGIN_US*CLOCK_TICKS_PER_US;
 }
 
-void CameraMount::testFrame() {
-	*(camera->pixel(0,0)) = threshold;
-	for(int r = ROW_START; r < ROW_END; r++) {
-		for(int c = COL_START; c < COL_END; c++) {
-			volatile unsigned char* px = camera->pixel(r,c);
-			if(*px < threshold)
-				*px = 0;
-			else
-				*px = 255;
-		}
+/*
+ * Control exposure and gain from the frames captured, or hand
+ * them back to the sensor
+ */
+void CameraMount::setAutoExposure(bool on) {
+	if(on) {
+		// start from wherever the sensor's own loop had settled
+		unsigned char aec, gain;
+		camera.getExposure(&aec, &gain);
+		exposure.start(aec, gain);
+	} else {
+		exposure.stop();
 	}
+	camera.setSensorExposure(!on);
+}
+
+/*
+ * Print the state of the exposure loop
+ */
+void CameraMount::printExposure() {
+	unsigned char aec, gain;
+	camera.getExposure(&aec, &gain);
+	printf("Auto exposure %s, exposure %d, gain %d, median level %d\n",
+			exposure.isEnabled() ? "ON" : "OFF", aec, gain, exposure.getLevel());
+}
+
+/*
+ * Segment the region of interest and choose the threshold
+ * that separates the target from the rest of the frame
+ */
+void CameraMount::updateThreshold() {
+	tracker.updateThreshold();
+}
+
+/*
+ * Select whether the tracker follows bright, moving, edged or coloured objects
+ */
+void CameraMount::setSegmentMode(SegmentMode mode) {
+	// only colour mode needs the sensor to send chroma
+	if((mode == SEGMENT_COLOR) != (tracker.getSegmentMode() == SEGMENT_COLOR))
+		camera.setCaptureMode(mode == SEGMENT_COLOR ? CAPTURE_YUV : CAPTURE_GREY);
+
+	tracker.setSegmentMode(mode);
+	overlay.clear();
 }
 
+/*
+ * Set the U and V ranges followed in colour mode
+ */
+void CameraMount::setColorBox(bool v, unsigned char min, unsigned char max) {
+	tracker.setColorBox(v, min, max);
+}
+
+/*
+ * Show the region of interest thresholded on the display
+ */
+void CameraMount::testFrame() {
+	overlay.threshold(params.rowStart, params.rowEnd, params.colStart, params.colEnd, tracker.getThreshold());
+}
+
+/*
+ * Draw the annotations of the last frame over it, once the
+ * frame is no longer needed for analysis
+ */
+void CameraMount::drawOverlay() {
+	overlay.box(params.rowStart, params.colStart, params.rowEnd - 1, params.colEnd - 1, 64);
+	overlay.cross(ROW_MID, COL_MID, 128);
+
+	char line[OVERLAY_TEXT];
+	unsigned int fps = framePeriod != 0 ? (CLOCK_TICKS_PER_US*1000000 + framePeriod/2) / framePeriod : 0;
+	snprintf(line, sizeof(line), "T%d %uFPS", tracker.getThreshold(), fps);
+	overlay.print(0, 0, line, 255);
+
+	overlay.render(camera.pixel(0,0));
+}
+
+/*
+ * Turn the annotations on or off
+ */
+void CameraMount::setOverlay(bool on) {
+	overlay.enable(on);
+}
+
+/*
+ * Drop the annotations not yet drawn, so none outlive the mode
+ * that made them
+ */
+void CameraMount::clearOverlay() {
+	overlay.clear();
+}
+
+/*
+ * Find the longest runs in the last frame captured and aim at them
+ */
 void CameraMount::adjustServos() {
-	const int ROW_MID = (ROW_END+ROW_START)/2;
-	const int COL_MID = (COL_END+COL_START)/2;
-	float adjPan = 0.0f;
-	float adjTilt = 0.0f;
-	int pxInARow = 0;
-
-	int maxInARow = 0;
-
-	int ulr = ROW_START;
-	int ulc = COL_START;
-
-	int lrr = ROW_END;
-	int lrc = COL_END;
-
-	for(int r = ROW_START; r < ROW_END; r++) {
-		for(int c = COL_START; c < COL_END; c++) {
-			unsigned char px = *(camera->pixel(r,c));
-			if(px > threshold) {
-				pxInARow++;
-			} else {
-				if(pxInARow > PXROW_TH_COLS && pxInARow > maxInARow) {
-					maxInARow = pxInARow;
-					ulc = c-pxInARow;
-					lrc = c-1;
-				}
-				pxInARow = 0;
-			}
-		}
+	tracker.findRuns();
+}
+
+/*
+ * Locate the target in the last frame captured with the
+ * selected tracker
+ */
+void CameraMount::track() {
+	tracker.track(mount.isSteady());
+}
+
+/*
+ * Move the servos so the target found in the last frame approaches
+ * the middle of the region of interest
+ */
+void CameraMount::control() {
+	if(report.found) {
+		float adjPan, adjTilt;
+		tracker.correction(&report, &adjPan, &adjTilt);
+
+		// corrections are from where the mount was when the frame was
+		// taken, not from where it was last sent, or motion still under
+		// way would be added again
+		tilt(mount.getFrameTilt() + adjTilt);
+		pan(mount.getFramePan() + adjPan);
 	}
 
-	pxInARow=0;
-	maxInARow = 0;
-	for(int c = COL_START; c < COL_END; c++) {
-		for(int r = ROW_START; r < ROW_END; r++) {
-			unsigned char px = *(camera->pixel(r,c));
-			if(px > threshold) {
-				pxInARow++;
-			} else {
-				if(pxInARow > PXROW_TH_ROWS && pxInARow > maxInARow) {
-					maxInARow = pxInARow;
-					ulr = r-pxInARow;
-					lrr = r-1;
-				}
-				pxInARow = 0;
-			}
+	report.controlled = Clock::now();
+	report.pan = mount.getPan();
+	report.tilt = mount.getTilt();
+}
+
+/*
+ * Select how the target is located in each frame
+ */
+void CameraMount::setTrackerMode(TrackerMode mode) {
+	tracker.setTrackerMode(mode);
+	overlay.clear();
+}
+
+/*
+ * Capture a frame and find the centroid of the largest blob,
+ * returns false if there is none
+ */
+bool CameraMount::locate(float* row, float* col) {
+	// a frame lost to a sync glitch is not a lost target
+	int tries = 0;
+	while(getCameraFrame(false) != FRAME_OK)
+		if(++tries >= FRAME_RETRIES)
+			return false;
+	return tracker.locate(row, col);
+}
+
+/*
+ * Move one axis by a step (degrees) and measure how far the target
+ * moves in the image and how many frames pass before it starts to,
+ * returns false if the target is lost or never moves
+ */
+bool CameraMount::stepResponse(bool tiltAxis, float step, float* shift, int* deadFrames, unsigned int* deadtime) {
+	float row, col;
+	float before = 0.0f;
+	float after = 0.0f;
+	bool ok = true;
+
+	for(int i = 0; i < CAL_AVERAGE && ok; i++) {
+		ok = locate(&row, &col);
+		before += tiltAxis ? row : col;
+	}
+	before /= CAL_AVERAGE;
+
+	float home = tiltAxis ? mount.getTilt() : mount.getPan();
+	unsigned int start = Clock::now();
+	if(tiltAxis)
+		tilt(home + step);
+	else
+		pan(home + step);
+
+	// wait for the target to start moving, then to stand still
+	int moved = -1;
+	int still = 0;
+	float last = before;
+	for(int f = 0; f < CAL_MAX_FRAMES && still < CAL_AVERAGE && ok; f++) {
+		ok = locate(&row, &col);
+		float px = tiltAxis ? row : col;
+
+		// up to the frame's VSYNC, the end of capture would add the
+		// readout, which placeFrame already spans
+		if(moved < 0 && Math::abs(px - before) > CAL_MOVED_PX) {
+			moved = f;
+			*deadtime = camera.getSyncTime() - start;
 		}
+		still = (moved >= 0 && Math::abs(px - last) < CAL_STILL_PX) ? still + 1 : 0;
+		last = px;
+	}
+
+	for(int i = 0; i < CAL_AVERAGE && ok; i++) {
+		ok = locate(&row, &col);
+		after += tiltAxis ? row : col;
+	}
+	after /= CAL_AVERAGE;
+
+	if(tiltAxis)
+		tilt(home);
+	else
+		pan(home);
+
+	*shift = after - before;
+	*deadFrames = moved;
+	return ok && moved >= 0;
+}
+
+/*
+ * Step each servo, measure the response of the target and use it
+ * as the servo gains, returns false if the target is lost or
+ * does not move
+ */
+bool CameraMount::calibrate() {
+	float panShift, tiltShift;
+	int panFrames, tiltFrames;
+	unsigned int panTime, tiltTime;
+
+	// step toward the middle of the travel so neither axis hits a stop
+	float panStep = mount.getPan() > 0.0f ? -CAL_STEP : CAL_STEP;
+	float tiltStep = mount.getTilt() > 45.0f ? -CAL_STEP : CAL_STEP;
+
+	if(!stepResponse(false, panStep, &panShift, &panFrames, &panTime) ||
+			!stepResponse(true, tiltStep, &tiltShift, &tiltFrames, &tiltTime)) {
+		printf("Calibration failed: target lost or not moving\n");
+		return false;
+	}
+
+	if(Math::abs(panShift) < CAL_MIN_SHIFT || Math::abs(tiltShift) < CAL_MIN_SHIFT) {
+		printf("Calibration failed: target moved %.1f/%.1f pixels\n", panShift, tiltShift);
+		return false;
+	}
+
+	// one full correction per error: frames that pass before the camera
+	// shows a move would otherwise apply the same error again
+	float adjPan = panStep / panShift / (float)(1 + panFrames);
+	float adjTilt = tiltStep / tiltShift / (float)(1 + tiltFrames);
+	unsigned int deadtime = Clock::toMicros(Math::max(panTime, tiltTime)) / 1000;
+
+	// set on a copy so a value out of range leaves every parameter as it was
+	TrackerParams fitted = params;
+	if(!Params::set(&fitted, "ADJ_PAN", adjPan) || !Params::set(&fitted, "ADJ_TILT", adjTilt) ||
+			!Params::set(&fitted, "SERVO_DEADTIME", (float)deadtime)) {
+		printf("Calibration failed: gains %f/%f or deadtime %u ms out of range\n", adjPan, adjTilt, deadtime);
+		return false;
 	}
+	params = fitted;
+
+	printf("Pan:  %.2f px/deg, %d frames late\n", panShift / panStep, panFrames);
+	printf("Tilt: %.2f px/deg, %d frames late\n", tiltShift / tiltStep, tiltFrames);
+	printf("SET ADJ_PAN %f\nSET ADJ_TILT %f\nSET SERVO_DEADTIME %u\n\n", adjPan, adjTilt, deadtime);
+	return true;
+}
+
+/*
+ * Select which target drives the servos when several are in view
+ */
+void CameraMount::setSelectPolicy(SelectPolicy policy) {
+	tracker.setSelectPolicy(policy);
+}
+
+/*
+ * Print the state of every target being followed
+ */
+void CameraMount::printTargets() {
+	tracker.printTargets();
+}
 
-	*(camera->pixel(ulr, ulc)) = 64;
-	*(camera->pixel(lrr, lrc)) = 196;
-	*(camera->pixel(ROW_MID, COL_MID)) = 128;
+/*
+ * Set a tracker parameter by name, returns false if the name
+ * is unknown or the value is out of range
+ */
+bool CameraMount::setParam(const char* name, float value) {
+	if(!Params::set(&params, name, value))
+		return false;
 
-	adjPan = (float)COL_MID - (((float)ulc) + ((float)lrc)) / 2.0f;
-	adjTilt = (float)ROW_MID - (((float)ulr) + ((float)lrr)) / 2.0f;
+	MotionEngine::setDeadband(params.servoDeadband);
+	return true;
+}
 
-	tilt(lastTilt + adjTilt * ADJ_FACTOR_TILT);
-	pan(lastPan + adjPan * ADJ_FACTOR_PAN);
+/*
+ * Get a tracker parameter by name, returns false if the name is unknown
+ */
+bool CameraMount::getParam(const char* name, float* value) {
+	return Params::get(&params, name, value);
+}
+
+/*
+ * Keep the current parameters as the ones restored by reset
+ * and print them as commands that recreate them
+ */
+void CameraMount::saveParams() {
+	saved = params;
+	Params::print(&saved);
+}
+
+/*
+ * Print the current parameters as commands that recreate them
+ */
+void CameraMount::printParams() {
+	Params::print(&params);
+}
+
+/*
+ * Get what the tracker did with the last frame
+ */
+const FrameReport* CameraMount::getReport() {
+	return &report;
 }
 
 /*
  * Read pixel data from the VGA memory
  */
 char CameraMount::getCameraPixel(int row, int column) {
-	return *(camera->pixel(row, column));
+	return *(camera.pixel(row, column));
+}
+
+/*
+ * Get the VGA memory holding the last frame and the threshold
+ * that separates its target
+ */
+volatile unsigned char* CameraMount::getCameraFrameData() {
+	return camera.pixel(0, 0);
+}
+
+unsigned char CameraMount::getThreshold() {
+	return tracker.getThreshold();
 }
 
 /*
- * Reset servo positions and camera registers
+ * Reset saved parameters, servo positions and camera registers
  */
 void CameraMount::reset() {
+	params = saved;
+	MotionEngine::setDeadband(params.servoDeadband);
+
 	pan(0.0f);
 	tilt(90.0f);
 
-	write(0x11, 0x08);
+	camera.setDivider(camera.getDivider());
 	usleep(100);
 	write(0x14, 1<<5);
 	usleep(100);
@@ -7,8 +7,16 @@
 #ifndef CAMERAMOUNT_HPP
 #define CAMERAMOUNT_HPP
 
-#include "Servo.hpp"
+#include "PanTilt.hpp"
 #include "Camera.hpp"
+#include "Exposure.hpp"
+#include "Overlay.hpp"
+#include "Params.hpp"
+#include "Tracker.hpp"
+#include "FrameReport.h"
+#include "SegmentMode.h"
+#include "TrackerMode.h"
+#include "SelectPolicy.h"
 
 /*
  * CameraMount class, ties pan/tilt servos and camera into
@@ -16,12 +24,30 @@
  */
 class CameraMount {
 private:
-	Servo* servoPan;
-	Servo* servoTilt;
-	Camera* camera;
-	unsigned char threshold;
-	float lastPan;
-	float lastTilt;
+	PanTilt mount;
+	Camera camera;
+	Exposure exposure;
+	Overlay overlay;
+	Tracker tracker;
+	int clockFrames;
+	unsigned int framePeriod;
+	bool exposurePending;
+	TrackerParams params;
+	TrackerParams saved;
+	FrameReport report;
+
+	/*
+	 * Capture a frame and find the centroid of the largest blob,
+	 * returns false if there is none
+	 */
+	bool locate(float* row, float* col);
+
+	/*
+	 * Move one axis by a step (degrees) and measure how far the target
+	 * moves in the image and how many frames pass before it starts to,
+	 * returns false if the target is lost or never moves
+	 */
+	bool stepResponse(bool tiltAxis, float step, float* shift, int* deadFrames, unsigned int* deadtime);
 
 protected:
 
@@ -43,24 +69,136 @@ public:
 	void tilt(float data);
 
 	/*
-	 * Print a camera frame to the VGA memory
+	 * Print a camera frame to the VGA memory, returns why the frame
+	 * was abandoned if it was, in which case it must not be used
 	 */
-	void getCameraFrame(bool debug);
+	FrameStatus getCameraFrame(bool debug);
 
+	/*
+	 * Find the fastest PCLK divider the capture loop keeps up with
+	 * and report the frame rate it gives, returns false if none
+	 * captured every line
+	 */
+	bool testClock();
+
+	/*
+	 * Control exposure and gain from the frames captured, or hand
+	 * them back to the sensor
+	 */
+	void setAutoExposure(bool on);
+
+	/*
+	 * Print the state of the exposure loop
+	 */
+	void printExposure();
+
+	/*
+	 * Show the region of interest thresholded on the display
+	 */
 	void testFrame();
 
+	/*
+	 * Draw the annotations of the last frame over it, once the
+	 * frame is no longer needed for analysis
+	 */
+	void drawOverlay();
+
+	/*
+	 * Turn the annotations on or off
+	 */
+	void setOverlay(bool on);
+
+	/*
+	 * Drop the annotations not yet drawn, so none outlive the mode
+	 * that made them
+	 */
+	void clearOverlay();
+
+	/*
+	 * Segment the region of interest and choose the threshold
+	 * that separates the target from the rest of the frame
+	 */
 	void updateThreshold();
 
 	/*
-	 * Adjust servos based on last frame captured
+	 * Select whether the tracker follows bright, moving, edged or coloured objects
+	 */
+	void setSegmentMode(SegmentMode mode);
+
+	/*
+	 * Set the U and V ranges followed in colour mode
+	 */
+	void setColorBox(bool v, unsigned char min, unsigned char max);
+
+	/*
+	 * Find the longest runs in the last frame captured and aim at them
 	 */
 	void adjustServos();
 
+	/*
+	 * Locate the target in the last frame captured with the
+	 * selected tracker
+	 */
+	void track();
+
+	/*
+	 * Move the servos so the target found in the last frame approaches
+	 * the middle of the region of interest
+	 */
+	void control();
+
+	/*
+	 * Get when the next frame capture has to start so its VSYNC is not
+	 * missed, predicted from the last frame's VSYNC and the frame period
+	 */
+	unsigned int frameDue();
+
+	/*
+	 * Check whether sensor registers are waiting to be written, and
+	 * write them
+	 */
+	bool sensorPending();
+	void serviceSensor();
+
+	/*
+	 * Select how the target is located in each frame
+	 */
+	void setTrackerMode(TrackerMode mode);
+
+	/*
+	 * Select which target drives the servos when several are in view
+	 */
+	void setSelectPolicy(SelectPolicy policy);
+
+	/*
+	 * Print the state of every target being followed
+	 */
+	void printTargets();
+
+	/*
+	 * Step each servo, measure the response of the target and use it
+	 * as the servo gains, returns false if the target is lost or
+	 * does not move
+	 */
+	bool calibrate();
+
+	/*
+	 * Get what the tracker did with the last frame
+	 */
+	const FrameReport* getReport();
+
 	/*
 	 * Read pixel data from the VGA memory
 	 */
 	char getCameraPixel(int row, int column);
 
+	/*
+	 * Get the VGA memory holding the last frame and the threshold
+	 * that separates its target
+	 */
+	volatile unsigned char* getCameraFrameData();
+	unsigned char getThreshold();
+
 	/*
 	 * Write a value to a camera register
 	 */
@@ -72,7 +210,29 @@ public:
 	char read(char subaddr);
 
 	/*
-	 * Reset servo positions and camera registers
+	 * Set a tracker parameter by name, returns false if the name
+	 * is unknown or the value is out of range
+	 */
+	bool setParam(const char* name, float value);
+
+	/*
+	 * Get a tracker parameter by name, returns false if the name is unknown
+	 */
+	bool getParam(const char* name, float* value);
+
+	/*
+	 * Keep the current parameters as the ones restored by reset
+	 * and print them as commands that recreate them
+	 */
+	void saveParams();
+
+	/*
+	 * Print the current parameters as commands that recreate them
+	 */
+	void printParams();
+
+	/*
+	 * Reset saved parameters, servo positions and camera registers
 	 */
 	void reset();
 };
@@ -0,0 +1,20 @@
+/*
+ * FILENAME:	CaptureMode.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef CAPTUREMODE_H
+#define CAPTUREMODE_H
+
+/*
+ * CaptureMode enum, determines which samples the sensor sends
+ * on the pixel port and which planes a frame is captured into
+ */
+enum CaptureMode {
+	CAPTURE_GREY, CAPTURE_YUV
+};
+
+typedef enum CaptureMode CaptureMode;
+
+#endif
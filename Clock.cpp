@@ -0,0 +1,41 @@
+/*
+ * FILENAME:	Clock.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Clock.hpp"
+#include "system.h"
+
+#include <altera_avalon_timer_regs.h>
+
+/*
+ * Start the counter
+ */
+void Clock::init() {
+	// count down through the whole 32 bit range, reloading forever
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(TIMER_1_BASE, ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+	IOWR_ALTERA_AVALON_TIMER_PERIODL(TIMER_1_BASE, 0xFFFF);
+	IOWR_ALTERA_AVALON_TIMER_PERIODH(TIMER_1_BASE, 0xFFFF);
+	IOWR_ALTERA_AVALON_TIMER_CONTROL(TIMER_1_BASE,
+			ALTERA_AVALON_TIMER_CONTROL_CONT_MSK | ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+}
+
+/*
+ * Get the current timestamp in CPU clock ticks
+ */
+unsigned int Clock::now() {
+	// any write latches the counter into the snapshot registers
+	IOWR_ALTERA_AVALON_TIMER_SNAPL(TIMER_1_BASE, 0);
+	unsigned int snap = (IORD_ALTERA_AVALON_TIMER_SNAPH(TIMER_1_BASE) << 16) | (IORD_ALTERA_AVALON_TIMER_SNAPL(TIMER_1_BASE) & 0xFFFF);
+
+	// counter runs down, timestamps run up
+	return ~snap;
+}
+
+/*
+ * Convert a tick interval to microseconds
+ */
+unsigned int Clock::toMicros(unsigned int ticks) {
+	return ticks / CLOCK_TICKS_PER_US;
+}
@@ -0,0 +1,34 @@
+/*
+ * FILENAME:	Clock.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+// Clock ticks per microsecond
+#define CLOCK_TICKS_PER_US 50
+
+/*
+ * Clock namespace, free running timestamp counter kept by the
+ * second interval timer, wraps every 85 seconds
+ */
+namespace Clock {
+	/*
+	 * Start the counter
+	 */
+	void init();
+
+	/*
+	 * Get the current timestamp in CPU clock ticks
+	 */
+	unsigned int now();
+
+	/*
+	 * Convert a tick interval to microseconds
+	 */
+	unsigned int toMicros(unsigned int ticks);
+}
+
+#endif /* CLOCK_HPP */
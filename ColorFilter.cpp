@@ -0,0 +1,63 @@
+/*
+ * FILENAME:	ColorFilter.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "ColorFilter.hpp"
+#include "Camera.hpp"
+
+// Default UV box, saturated red
+#define U_MIN_INIT 64
+#define U_MAX_INIT 120
+#define V_MIN_INIT 160
+#define V_MAX_INIT 240
+
+/*
+ * Constructor, default box selects saturated red
+ */
+ColorFilter::ColorFilter() {
+	setUBox(U_MIN_INIT, U_MAX_INIT);
+	setVBox(V_MIN_INIT, V_MAX_INIT);
+}
+
+/*
+ * Set the range of U values that belong to the target
+ */
+void ColorFilter::setUBox(unsigned char min, unsigned char max) {
+	uMin = min;
+	uMax = max;
+}
+
+/*
+ * Set the range of V values that belong to the target
+ */
+void ColorFilter::setVBox(unsigned char min, unsigned char max) {
+	vMin = min;
+	vMax = max;
+}
+
+/*
+ * Write 255 over target pixels and 0 elsewhere in the region
+ * of the frame, returns the threshold to apply to the mask
+ */
+unsigned char ColorFilter::apply(volatile unsigned char* frame, const unsigned char* u, const unsigned char* v,
+		int rowStart, int rowEnd, int colStart, int colEnd) {
+	// one unsigned compare per channel checks both ends of the box
+	unsigned int uSpan = uMax - uMin;
+	unsigned int vSpan = vMax - vMin;
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		volatile unsigned char* px = frame + (r<<VGA_ROW_SHIFT);
+		const unsigned char* pu = u + r*VGA_COLUMNS;
+		const unsigned char* pv = v + r*VGA_COLUMNS;
+
+		for(int c = colStart; c < colEnd; c++) {
+			bool in = ((unsigned int)(pu[c] - uMin) <= uSpan) && ((unsigned int)(pv[c] - vMin) <= vSpan);
+			px[c] = in ? 255 : 0;
+		}
+	}
+
+	// the mask is binary, no statistics pass is needed
+	return 128;
+}
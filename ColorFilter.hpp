@@ -0,0 +1,47 @@
+/*
+ * FILENAME:	ColorFilter.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef COLORFILTER_HPP
+#define COLORFILTER_HPP
+
+/*
+ * ColorFilter class, marks the pixels of a YUV frame whose
+ * chroma falls inside a box in the UV plane
+ */
+class ColorFilter {
+private:
+	unsigned char uMin;
+	unsigned char uMax;
+	unsigned char vMin;
+	unsigned char vMax;
+
+protected:
+
+public:
+	/*
+	 * Constructor, default box selects saturated red
+	 */
+	ColorFilter();
+
+	/*
+	 * Set the range of U values that belong to the target
+	 */
+	void setUBox(unsigned char min, unsigned char max);
+
+	/*
+	 * Set the range of V values that belong to the target
+	 */
+	void setVBox(unsigned char min, unsigned char max);
+
+	/*
+	 * Write 255 over target pixels and 0 elsewhere in the region
+	 * of the frame, returns the threshold to apply to the mask
+	 */
+	unsigned char apply(volatile unsigned char* frame, const unsigned char* u, const unsigned char* v,
+			int rowStart, int rowEnd, int colStart, int colEnd);
+};
+
+#endif /* COLORFILTER_HPP */
@@ -0,0 +1,164 @@
+/*
+ * FILENAME:	Console.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Console.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Constructor, table must be sorted by name
+ */
+Console::Console(const Command* table, int size) : length(0), ready(false), table(table), size(size) {
+	// reads return immediately when the JTAG UART has nothing waiting
+	fcntl(STDIN_FILENO, F_SETFL, O_NONBLOCK);
+}
+
+/*
+ * Read whatever input is waiting, returns true once a whole
+ * line is ready to execute
+ */
+bool Console::poll() {
+	char ch;
+
+	while(!ready && read(STDIN_FILENO, &ch, 1) == 1) {
+		if(ch == '\n' || ch == '\r') {
+			// ignore the second half of CR LF
+			if(length == 0)
+				continue;
+			line[length] = '\0';
+			ready = true;
+		} else if(ch == '\b' || ch == 0x7F) {
+			if(length > 0)
+				length--;
+		} else if(length < BUFFER_SIZE-1) {
+			line[length++] = ch;
+		}
+	}
+
+	return ready;
+}
+
+/*
+ * Run the command on the ready line
+ */
+void Console::execute() {
+	char* tokens[MAX_ARGS+1];
+	Arg args[MAX_ARGS];
+
+	int count = tokenize(tokens, MAX_ARGS+1);
+	ready = false;
+	length = 0;
+
+	if(count == 0)
+		return;
+
+	const Command* cmd = lookup(tokens[0]);
+	if(cmd == NULL || !parse(cmd, tokens+1, count-1, args)) {
+		printf("ERROR: Invalid command\n");
+		return;
+	}
+
+	cmd->handler(args);
+}
+
+/*
+ * Print the usage and help of every command
+ */
+void Console::help() {
+	printf("Commands:\n");
+	for(int i = 0; i < size; i++)
+		printf("%s\n  %s\n\n", table[i].usage, table[i].help);
+}
+
+/*
+ * Split the line in place on whitespace, returns the token count
+ */
+int Console::tokenize(char** tokens, int max) {
+	int count = 0;
+	char* p = line;
+
+	while(*p != '\0') {
+		while(*p == ' ' || *p == '\t')
+			*(p++) = '\0';
+		if(*p == '\0')
+			break;
+
+		// too many tokens, report the line as invalid
+		if(count == max)
+			return 0;
+		tokens[count++] = p;
+
+		while(*p != '\0' && *p != ' ' && *p != '\t')
+			p++;
+	}
+
+	return count;
+}
+
+/*
+ * Binary search the table, NULL if the command is unknown
+ */
+const Command* Console::lookup(const char* name) {
+	int lo = 0;
+	int hi = size - 1;
+
+	while(lo <= hi) {
+		int mid = (lo + hi) / 2;
+		int cmp = strcmp(name, table[mid].name);
+		if(cmp == 0)
+			return &table[mid];
+		if(cmp < 0)
+			hi = mid - 1;
+		else
+			lo = mid + 1;
+	}
+
+	return NULL;
+}
+
+/*
+ * Convert the tokens to the argument types of a command,
+ * returns false if any of them does not fit
+ */
+bool Console::parse(const Command* cmd, char** tokens, int count, Arg* args) {
+	if(count != (int)strlen(cmd->args))
+		return false;
+
+	for(int n = 0; n < count; n++) {
+		char* end;
+
+		switch(cmd->args[n]) {
+		case 'i':
+			args[n].i = (int)strtoul(tokens[n], &end, 0);
+			if(*end != '\0')
+				return false;
+			break;
+		case 'f':
+			args[n].f = strtof(tokens[n], &end);
+			if(*end != '\0')
+				return false;
+			break;
+		case 'k':
+			args[n].i = -1;
+			for(int k = 0; cmd->keys[k] != NULL; k++) {
+				if(strcmp(tokens[n], cmd->keys[k]) == 0)
+					args[n].i = k;
+			}
+			if(args[n].i < 0)
+				return false;
+			break;
+		default:
+			args[n].s = tokens[n];
+			break;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,90 @@
+/*
+ * FILENAME:	Console.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef CONSOLE_HPP
+#define CONSOLE_HPP
+
+// Input constants
+#define BUFFER_SIZE 80
+#define MAX_ARGS 8
+
+/*
+ * Arg union, one parsed command argument
+ */
+union Arg {
+	int i;
+	float f;
+	const char* s;
+};
+
+/*
+ * Command struct, one entry of a command table. Each character of
+ * args is one argument: 'i' integer, 'f' float, 's' string, 'k' one
+ * of keys (passed as its index).
+ */
+struct Command {
+	const char* name;
+	const char* args;
+	const char* const* keys;
+	void (*handler)(const Arg* args);
+	const char* usage;
+	const char* help;
+};
+
+/*
+ * Console class, assembles input lines from the JTAG UART without
+ * blocking and dispatches them through a table of commands
+ */
+class Console {
+private:
+	char line[BUFFER_SIZE];
+	int length;
+	bool ready;
+	const Command* table;
+	int size;
+
+	/*
+	 * Split the line in place on whitespace, returns the token count
+	 */
+	int tokenize(char** tokens, int max);
+
+	/*
+	 * Binary search the table, NULL if the command is unknown
+	 */
+	const Command* lookup(const char* name);
+
+	/*
+	 * Convert the tokens to the argument types of a command,
+	 * returns false if any of them does not fit
+	 */
+	bool parse(const Command* cmd, char** tokens, int count, Arg* args);
+
+protected:
+
+public:
+	/*
+	 * Constructor, table must be sorted by name
+	 */
+	Console(const Command* table, int size);
+
+	/*
+	 * Read whatever input is waiting, returns true once a whole
+	 * line is ready to execute
+	 */
+	bool poll();
+
+	/*
+	 * Run the command on the ready line
+	 */
+	void execute();
+
+	/*
+	 * Print the usage and help of every command
+	 */
+	void help();
+};
+
+#endif /* CONSOLE_HPP */
@@ -0,0 +1,158 @@
+/*
+ * FILENAME:	EdgeFilter.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "EdgeFilter.hpp"
+#include "Camera.hpp"
+#include "Math.hpp"
+#include "Arena.hpp"
+#include "Onchip.h"
+
+#include <stddef.h>
+
+// Gradients are kept positive in their 16 bit lanes with this bias
+#define GRAD_BIAS 1024
+#define GRAD_BIAS_PAIR ((GRAD_BIAS<<16) | GRAD_BIAS)
+#define DIFF_BIAS_PAIR ((256<<16) | 256)
+
+// Edge magnitude is averaged over this many columns (power of two)
+#define EDGE_WINDOW_SHIFT 3
+#define EDGE_WINDOW (1<<EDGE_WINDOW_SHIFT)
+
+// Smallest edge density that can ever count as a target
+#define EDGE_TH_MIN 16
+
+#define VGA_WORDS (VGA_COLUMNS/4)
+#define VGA_PAIRS (VGA_COLUMNS/2)
+
+// Rolling window of three raw frame rows, read for every output pixel
+static SCRATCH unsigned int rows[3][VGA_WORDS] ONCHIP CACHE_ALIGNED;
+
+// Vertical Sobel terms for two columns per word, column 2k in the low lane:
+// smooth = top + 2*middle + bottom, diff = bottom - top + 256
+static SCRATCH unsigned int* smooth;
+static SCRATCH unsigned int* diff;
+
+// Edge magnitude of the row being filtered, zero outside the computed columns
+static SCRATCH unsigned char* magnitude;
+
+/*
+ * Copy one frame row into the window with word reads
+ */
+static void loadRow(unsigned int* dst, volatile unsigned char* frame, int row) {
+	volatile unsigned int* src = (volatile unsigned int*)(frame + (row<<VGA_ROW_SHIFT));
+	for(int w = 0; w < VGA_WORDS; w++)
+		dst[w] = src[w];
+}
+
+/*
+ * Absolute value of a biased gradient lane
+ */
+static inline int lane(unsigned int v) {
+	int g = (int)(v & 0xFFFF) - GRAD_BIAS;
+	return g < 0 ? -g : g;
+}
+
+/*
+ * Sobel magnitude of the middle window row, two columns at a time
+ */
+HOT static void sobel(unsigned int* top, unsigned int* mid, unsigned int* bot) {
+	// spread each group of four pixels into two words of 16 bit lanes
+	for(int w = 0; w < VGA_WORDS; w++) {
+		unsigned int t = top[w];
+		unsigned int m = mid[w];
+		unsigned int b = bot[w];
+
+		unsigned int tl = (t & 0xFF) | ((t << 8) & 0xFF0000);
+		unsigned int ml = (m & 0xFF) | ((m << 8) & 0xFF0000);
+		unsigned int bl = (b & 0xFF) | ((b << 8) & 0xFF0000);
+		unsigned int th = ((t >> 16) & 0xFF) | ((t >> 8) & 0xFF0000);
+		unsigned int mh = ((m >> 16) & 0xFF) | ((m >> 8) & 0xFF0000);
+		unsigned int bh = ((b >> 16) & 0xFF) | ((b >> 8) & 0xFF0000);
+
+		smooth[2*w] = tl + (ml << 1) + bl;
+		smooth[2*w+1] = th + (mh << 1) + bh;
+		diff[2*w] = bl + DIFF_BIAS_PAIR - tl;
+		diff[2*w+1] = bh + DIFF_BIAS_PAIR - th;
+	}
+
+	// output columns 2k+1 and 2k+2 come from lane pairs k and k+1
+	for(int k = 0; k < VGA_PAIRS-1; k++) {
+		unsigned int gx = smooth[k+1] + GRAD_BIAS_PAIR - smooth[k];
+		unsigned int centre = (diff[k] >> 16) | (diff[k+1] << 16);
+		unsigned int gy = diff[k] + (centre << 1) + diff[k+1];
+
+		int m0 = (lane(gx) + lane(gy)) >> 2;
+		int m1 = (lane(gx >> 16) + lane(gy >> 16)) >> 2;
+		magnitude[2*k+1] = m0 > 255 ? 255 : m0;
+		magnitude[2*k+2] = m1 > 255 ? 255 : m1;
+	}
+}
+
+/*
+ * Constructor
+ */
+EdgeFilter::EdgeFilter() { }
+
+/*
+ * Write the edge density over the region of the frame in a single
+ * pass, returns the threshold to apply to the edge density
+ */
+HOT unsigned char EdgeFilter::apply(volatile unsigned char* frame, int rowStart, int rowEnd, int colStart, int colEnd) {
+	unsigned char max = 0;
+	unsigned char min = 255;
+
+	unsigned int* top = rows[0];
+	unsigned int* mid = rows[1];
+	unsigned int* bot = rows[2];
+
+	unsigned int mark = Arena::mark();
+	smooth = (unsigned int*)Arena::take(VGA_PAIRS * 4);
+	diff = (unsigned int*)Arena::take(VGA_PAIRS * 4);
+	magnitude = (unsigned char*)Arena::take(VGA_COLUMNS);
+	if(magnitude == NULL) {
+		Arena::release(mark);
+		return 255;
+	}
+	magnitude[0] = 0;
+	magnitude[VGA_COLUMNS-1] = 0;
+
+	// the density window has to stay inside the computed columns
+	colStart = Math::max(colStart, EDGE_WINDOW/2 + 1);
+	colEnd = Math::min(colEnd, VGA_COLUMNS - EDGE_WINDOW/2);
+
+	loadRow(top, frame, Math::max(rowStart - 1, 0));
+	loadRow(mid, frame, rowStart);
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		// raw rows are all in the window before row r is overwritten
+		loadRow(bot, frame, Math::min(r + 1, VGA_ROWS - 1));
+		sobel(top, mid, bot);
+
+		// running sum of magnitude over the columns around each pixel
+		int sum = 0;
+		for(int c = colStart - EDGE_WINDOW/2; c < colStart + EDGE_WINDOW/2; c++)
+			sum += magnitude[c];
+
+		volatile unsigned char* px = frame + (r<<VGA_ROW_SHIFT);
+		for(int c = colStart; c < colEnd; c++) {
+			unsigned char density = sum >> EDGE_WINDOW_SHIFT;
+			px[c] = density;
+			max = density > max ? density : max;
+			min = density < min ? density : min;
+
+			sum += magnitude[c + EDGE_WINDOW/2] - magnitude[c - EDGE_WINDOW/2];
+		}
+
+		// roll the window down one row
+		unsigned int* t = top;
+		top = mid;
+		mid = bot;
+		bot = t;
+	}
+
+	Arena::release(mark);
+	return Math::max<unsigned char>((max>>1) + (min>>1), EDGE_TH_MIN);
+}
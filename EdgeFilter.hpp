@@ -0,0 +1,33 @@
+/*
+ * FILENAME:	EdgeFilter.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef EDGEFILTER_HPP
+#define EDGEFILTER_HPP
+
+/*
+ * EdgeFilter class, replaces a region of the frame with the local
+ * density of Sobel edge magnitude so textured or outlined objects
+ * stand out regardless of how evenly they are lit
+ */
+class EdgeFilter {
+private:
+
+protected:
+
+public:
+	/*
+	 * Constructor
+	 */
+	EdgeFilter();
+
+	/*
+	 * Write the edge density over the region of the frame in a single
+	 * pass, returns the threshold to apply to the edge density
+	 */
+	unsigned char apply(volatile unsigned char* frame, int rowStart, int rowEnd, int colStart, int colEnd);
+};
+
+#endif /* EDGEFILTER_HPP */
@@ -0,0 +1,159 @@
+/*
+ * FILENAME:	Exposure.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Exposure.hpp"
+#include "Pyramid.hpp"
+#include "Math.hpp"
+#include "Onchip.h"
+
+// Histogram of the coarse level, 8 grey levels per bin
+#define AE_BIN_SHIFT 3
+#define AE_BINS (256>>AE_BIN_SHIFT)
+#define AE_CELLS (PYR2_ROWS*PYR2_COLUMNS)
+
+// Median level aimed for
+#define AE_TARGET 112
+// Error that starts a correction, and that ends it
+#define AE_START 24
+#define AE_STOP 8
+// Frames between updates, the sensor applies new values a frame late
+#define AE_PERIOD 3
+
+// Brightest pixel and share of coarse cells in the top bin that
+// mean highlights are clipping
+#define AE_CLIP 248
+#define AE_CLIPPED (AE_CELLS/16)
+
+// Exposure and gain register ranges, gain moves in fixed steps
+#define AEC_MIN 1
+#define AEC_MAX 255
+#define GAIN_MIN 0
+#define GAIN_MAX 63
+#define GAIN_STEP 4
+
+// Largest change of exposure in one update (Q8, x2 or /2)
+#define SCALE_MIN 128
+#define SCALE_MAX 512
+
+static unsigned short histogram[AE_BINS] ONCHIP;
+
+/*
+ * Constructor, control starts disabled
+ */
+Exposure::Exposure() {
+	enabled = false;
+	correcting = false;
+	frames = 0;
+	level = AE_TARGET;
+	aec = AEC_MAX;
+	gain = GAIN_MIN;
+}
+
+/*
+ * Take over control from the exposure and gain the sensor is using
+ */
+void Exposure::start(int aec, int gain) {
+	this->aec = Math::clamp(aec, AEC_MIN, AEC_MAX);
+	this->gain = Math::clamp(gain, GAIN_MIN, GAIN_MAX);
+	enabled = true;
+	correcting = false;
+	frames = 0;
+}
+
+/*
+ * Stop issuing new values
+ */
+void Exposure::stop() {
+	enabled = false;
+}
+
+/*
+ * Check whether the loop is in control
+ */
+bool Exposure::isEnabled() {
+	return enabled;
+}
+
+/*
+ * Judge the last frame from its coarse level and brightest
+ * pixel, returns true if a new exposure and gain
+ * should be written to the sensor
+ */
+bool Exposure::update(const Pyramid* pyramid, unsigned char max) {
+	if(!enabled)
+		return false;
+	if(frames < AE_PERIOD)
+		frames++;
+
+	for(int i = 0; i < AE_BINS; i++)
+		histogram[i] = 0;
+	const unsigned char* cell = &pyramid->level2[0][0];
+	for(int i = 0; i < AE_CELLS; i++)
+		histogram[cell[i] >> AE_BIN_SHIFT]++;
+
+	// median, interpolated within its bin
+	int count = 0;
+	int bin = 0;
+	while(count + histogram[bin] <= AE_CELLS/2)
+		count += histogram[bin++];
+	level = (bin << AE_BIN_SHIFT) + ((AE_CELLS/2 - count) << AE_BIN_SHIFT) / histogram[bin];
+
+	// a large clipped area is too bright whatever the median says,
+	// a small one is likely the target and is left alone
+	int error = level - AE_TARGET;
+	if(max >= AE_CLIP && histogram[AE_BINS-1] > AE_CLIPPED)
+		error = Math::max(error, AE_START + 1);
+
+	correcting = Math::abs(error) > (correcting ? AE_STOP : AE_START);
+	if(!correcting || frames < AE_PERIOD)
+		return false;
+
+	// exposure scaled toward the target, at most doubled or halved
+	int scale = Math::clamp((AE_TARGET << 8) / Math::max(level, 1), SCALE_MIN, SCALE_MAX);
+	int lastAec = aec;
+	int lastGain = gain;
+	if(error < 0) {
+		// too dark, gain only once the exposure is at its longest
+		if(aec < AEC_MAX)
+			aec = Math::min(Math::max((aec*scale) >> 8, aec + 1), AEC_MAX);
+		else
+			gain = Math::min(gain + GAIN_STEP, GAIN_MAX);
+	} else {
+		// too bright, gain goes first since it only adds noise
+		if(gain > GAIN_MIN)
+			gain = Math::max(gain - GAIN_STEP, GAIN_MIN);
+		else
+			aec = Math::max(Math::min((aec*scale) >> 8, aec - 1), AEC_MIN);
+	}
+
+	// at the end of both ranges there is nothing to write
+	if(aec == lastAec && gain == lastGain)
+		return false;
+
+	frames = 0;
+	return true;
+}
+
+/*
+ * Get the exposure to write
+ */
+int Exposure::getExposure() {
+	return aec;
+}
+
+/*
+ * Get the gain to write
+ */
+int Exposure::getGain() {
+	return gain;
+}
+
+/*
+ * Get the median level of the last frame judged
+ */
+int Exposure::getLevel() {
+	return level;
+}
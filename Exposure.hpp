@@ -0,0 +1,68 @@
+/*
+ * FILENAME:	Exposure.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef EXPOSURE_HPP
+#define EXPOSURE_HPP
+
+class Pyramid;
+
+/*
+ * Exposure class, closed loop exposure and gain control. Each frame
+ * is judged from a histogram of the coarse pyramid level and the
+ * brightest pixel found during capture. Corrections start when the median
+ * leaves a wide band around the target and continue until it is back
+ * inside a narrow one, and new values are issued at most once every
+ * few frames so the sensor has applied the last ones before the next
+ * decision.
+ */
+class Exposure {
+private:
+	bool enabled;
+	bool correcting;
+	int frames;
+	int level;
+	int aec;
+	int gain;
+
+protected:
+
+public:
+	/*
+	 * Constructor, control starts disabled
+	 */
+	Exposure();
+
+	/*
+	 * Take over control from the exposure and gain the sensor is using
+	 */
+	void start(int aec, int gain);
+
+	/*
+	 * Stop issuing new values
+	 */
+	void stop();
+
+	/*
+	 * Check whether the loop is in control
+	 */
+	bool isEnabled();
+
+	/*
+	 * Judge the last frame from its coarse level and brightest
+	 * pixel, returns true if a new exposure and gain
+	 * should be written to the sensor
+	 */
+	bool update(const Pyramid* pyramid, unsigned char max);
+
+	/*
+	 * Get the values to write, and the median level of the last frame
+	 */
+	int getExposure();
+	int getGain();
+	int getLevel();
+};
+
+#endif /* EXPOSURE_HPP */
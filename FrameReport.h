@@ -0,0 +1,41 @@
+/*
+ * FILENAME:	FrameReport.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef FRAMEREPORT_H
+#define FRAMEREPORT_H
+
+/*
+ * FrameReport struct, what the tracker did with the last frame
+ */
+struct FrameReport {
+	// stage boundaries, Clock timestamps
+	unsigned int start;
+	unsigned int captured;
+	unsigned int analyzed;
+	unsigned int controlled;
+
+	unsigned char threshold;
+	int segment;
+	int tracker;
+
+	// target, the box is only known to some trackers
+	bool found;
+	bool hasBox;
+	float row;
+	float col;
+	int ulr;
+	int ulc;
+	int lrr;
+	int lrc;
+
+	// commanded servo positions, degrees
+	float pan;
+	float tilt;
+};
+
+typedef struct FrameReport FrameReport;
+
+#endif
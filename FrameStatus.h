@@ -0,0 +1,23 @@
+/*
+ * FILENAME:	FrameStatus.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef FRAMESTATUS_H
+#define FRAMESTATUS_H
+
+/*
+ * FrameStatus enum, whether a capture completed or why it was
+ * abandoned: the sensor went quiet (no VSYNC, HREF or PCLK), a line
+ * had fewer or more pixels than the sensor sends, or the next frame
+ * started before every line of this one arrived
+ */
+enum FrameStatus {
+	FRAME_OK, FRAME_NO_VSYNC, FRAME_NO_HREF, FRAME_NO_PCLK,
+	FRAME_SHORT_LINE, FRAME_LONG_LINE, FRAME_SHORT_FRAME
+};
+
+typedef enum FrameStatus FrameStatus;
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * FILENAME:	Link.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Link.hpp"
+#include "system.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Nobody holds the link
+#define LINK_FREE (-1)
+
+/*
+ * Constructor, opens a non-blocking stream to the JTAG UART
+ */
+Link::Link() : owner(LINK_FREE) {
+	fd = open(JTAG_UART_0_NAME, O_WRONLY | O_NONBLOCK);
+}
+
+/*
+ * Write as much of a unit as the link accepts right now, returns
+ * the bytes written, 0 if another stream holds the link
+ */
+int Link::send(int who, const void* data, int length) {
+	if(owner != LINK_FREE && owner != who)
+		return 0;
+
+	int n = write(fd, data, length);
+	if(n <= 0)
+		return 0;
+
+	owner = who;
+	return n;
+}
+
+/*
+ * Let other streams use the link once a unit is complete
+ */
+void Link::release(int who) {
+	if(owner == who)
+		owner = LINK_FREE;
+}
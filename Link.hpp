@@ -0,0 +1,44 @@
+/*
+ * FILENAME:	Link.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef LINK_HPP
+#define LINK_HPP
+
+// Streams sharing the link
+#define LINK_TELEMETRY 0
+#define LINK_PREVIEW 1
+
+/*
+ * Link class, non-blocking binary output on the JTAG UART shared by
+ * several streams. A stream holds the link from the first byte of a
+ * unit (record, chunk) until it releases it, so units never interleave.
+ */
+class Link {
+private:
+	int fd;
+	int owner;
+
+protected:
+
+public:
+	/*
+	 * Constructor, opens a non-blocking stream to the JTAG UART
+	 */
+	Link();
+
+	/*
+	 * Write as much of a unit as the link accepts right now, returns
+	 * the bytes written, 0 if another stream holds the link
+	 */
+	int send(int who, const void* data, int length);
+
+	/*
+	 * Let other streams use the link once a unit is complete
+	 */
+	void release(int who);
+};
+
+#endif /* LINK_HPP */
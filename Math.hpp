@@ -32,6 +32,13 @@ namespace Math {
 		return Math::max(min, Math::min(val, max));
 	}
 
+	/*
+	 * Magnitude of a value
+	 */
+	template <typename T> T abs(T val) {
+		return val < 0 ? -val : val;
+	}
+
 	/*
 	 * Check if a value is in a range
 	 */
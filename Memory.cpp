@@ -0,0 +1,201 @@
+/*
+ * FILENAME:	Memory.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Memory.hpp"
+#include "Arena.hpp"
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Bytes read from memory per output batch, a multiple of DUMP_LINE
+#define DUMP_CHUNK 256
+
+// Bytes per line of hex output
+#define DUMP_LINE 16
+
+// Characters per line of hex output, "0x00000000: " and "00 " per byte
+#define DUMP_LINE_TEXT (12 + 3*DUMP_LINE + 1)
+
+// Words are copied when both addresses fall on the same byte of a word
+#define WORD_MASK 3u
+
+static const char hex[] = "0123456789ABCDEF";
+
+/*
+ * Read a single byte from memory
+ */
+char Memory::read(int address) {
+	volatile char* ptr = (char*)address;
+	return *ptr;
+}
+
+/*
+ * Write a byte to memory
+ */
+void Memory::write(int address, char value) {
+	volatile char* ptr = (char*)address;
+	*ptr = value;
+}
+
+/*
+ * Print a range of bytes (inclusive) as hex, or send them raw
+ * after a "RAW <length>" line. Memory is read a word at a time.
+ */
+void Memory::dump(unsigned int addr1, unsigned int addr2, bool raw) {
+	if(addr2 < addr1)
+		return;
+
+	// staging for one batch, one extra word for an unaligned start
+	unsigned int mark = Arena::mark();
+	unsigned int* chunk = (unsigned int*)Arena::take(DUMP_CHUNK + 4);
+	char* text = (char*)Arena::take((DUMP_CHUNK/DUMP_LINE) * DUMP_LINE_TEXT);
+	if(text == NULL) {
+		Arena::release(mark);
+		return;
+	}
+
+	if(raw)
+		printf("RAW %u\n", addr2 - addr1 + 1);
+	else
+		printf("Memory Read:\n");
+
+	unsigned int addr = addr1;
+	while(true) {
+		unsigned int last = addr2 - addr < DUMP_CHUNK - 1 ? addr2 : addr + DUMP_CHUNK - 1;
+
+		// whole words covering the batch
+		volatile unsigned int* src = (unsigned int*)(addr & ~WORD_MASK);
+		int words = ((last & ~WORD_MASK) - (addr & ~WORD_MASK)) / 4 + 1;
+		for(int i = 0; i < words; i++)
+			chunk[i] = src[i];
+
+		const unsigned char* bytes = (const unsigned char*)chunk + (addr & WORD_MASK);
+		int length = last - addr + 1;
+
+		if(raw) {
+			fwrite(bytes, 1, length, stdout);
+		} else {
+			char* t = text;
+			for(int i = 0; i < length; i++) {
+				if((i % DUMP_LINE) == 0) {
+					if(i > 0)
+						*(t++) = '\n';
+					unsigned int a = addr + i;
+					*(t++) = '0';
+					*(t++) = 'x';
+					for(int shift = 28; shift >= 0; shift -= 4)
+						*(t++) = hex[(a >> shift) & 0xF];
+					*(t++) = ':';
+					*(t++) = ' ';
+				}
+				*(t++) = hex[bytes[i] >> 4];
+				*(t++) = hex[bytes[i] & 0xF];
+				*(t++) = ' ';
+			}
+			*(t++) = '\n';
+			fwrite(text, 1, t - text, stdout);
+		}
+
+		if(last == addr2)
+			break;
+		addr = last + 1;
+	}
+
+	if(raw)
+		printf("\n");
+	fflush(stdout);
+	Arena::release(mark);
+}
+
+/*
+ * Set a range of bytes (inclusive) to one value
+ */
+void Memory::fill(unsigned int addr1, unsigned int addr2, unsigned char value) {
+	if(addr2 < addr1)
+		return;
+
+	volatile unsigned char* dst = (unsigned char*)addr1;
+	volatile unsigned char* end = (unsigned char*)addr2 + 1;
+
+	// bytes up to the first word
+	while(dst < end && ((unsigned int)dst & WORD_MASK))
+		*(dst++) = value;
+
+	// whole words, four at a time
+	unsigned int pattern = value * 0x01010101u;
+	volatile unsigned int* wdst = (unsigned int*)dst;
+	volatile unsigned int* wend = (unsigned int*)((unsigned int)end & ~WORD_MASK);
+	while(wdst + 4 <= wend) {
+		wdst[0] = pattern;
+		wdst[1] = pattern;
+		wdst[2] = pattern;
+		wdst[3] = pattern;
+		wdst += 4;
+	}
+	while(wdst < wend)
+		*(wdst++) = pattern;
+
+	// bytes after the last word
+	dst = (unsigned char*)wdst;
+	while(dst < end)
+		*(dst++) = value;
+}
+
+/*
+ * Copy a range of bytes (inclusive) to another address,
+ * the ranges may overlap
+ */
+void Memory::copy(unsigned int addr1, unsigned int addr2, unsigned int dest) {
+	if(addr2 < addr1 || dest == addr1)
+		return;
+
+	unsigned int length = addr2 - addr1 + 1;
+	bool words = ((addr1 ^ dest) & WORD_MASK) == 0;
+
+	if(dest < addr1 || dest > addr2) {
+		// forward, destination never overtakes the source
+		volatile unsigned char* src = (unsigned char*)addr1;
+		volatile unsigned char* dst = (unsigned char*)dest;
+		volatile unsigned char* end = dst + length;
+
+		if(words) {
+			while(dst < end && ((unsigned int)dst & WORD_MASK))
+				*(dst++) = *(src++);
+
+			volatile unsigned int* wsrc = (unsigned int*)src;
+			volatile unsigned int* wdst = (unsigned int*)dst;
+			volatile unsigned int* wend = (unsigned int*)((unsigned int)end & ~WORD_MASK);
+			while(wdst < wend)
+				*(wdst++) = *(wsrc++);
+
+			src = (unsigned char*)wsrc;
+			dst = (unsigned char*)wdst;
+		}
+		while(dst < end)
+			*(dst++) = *(src++);
+	} else {
+		// backward, destination starts inside the source
+		volatile unsigned char* src = (unsigned char*)addr2 + 1;
+		volatile unsigned char* dst = (unsigned char*)dest + length;
+		volatile unsigned char* begin = (unsigned char*)dest;
+
+		if(words) {
+			while(dst > begin && ((unsigned int)dst & WORD_MASK))
+				*(--dst) = *(--src);
+
+			volatile unsigned int* wsrc = (unsigned int*)src;
+			volatile unsigned int* wdst = (unsigned int*)dst;
+			volatile unsigned int* wbegin = (unsigned int*)(((unsigned int)begin + WORD_MASK) & ~WORD_MASK);
+			while(wdst > wbegin)
+				*(--wdst) = *(--wsrc);
+
+			src = (unsigned char*)wsrc;
+			dst = (unsigned char*)wdst;
+		}
+		while(dst > begin)
+			*(--dst) = *(--src);
+	}
+}
@@ -15,32 +15,29 @@ namespace Memory {
 	/*
 	 * Read a single byte from memory
 	 */
-	char read(int address) {
-		volatile char* ptr = (char*)address;
-		return *ptr;
-	}
+	char read(int address);
 
 	/*
-	 * Read a range of bytes from memory
+	 * Write a byte to memory
 	 */
-	char* readRange(int addr1, int addr2) {
-		char* rv = new char[addr2 - addr1 + 1];
-		char* wr = rv;
+	void write(int address, char value);
 
-		volatile char* ptr = (char*)addr1;
-		while(ptr <= (char*)addr2)
-			*(wr++) = *(ptr++);
+	/*
+	 * Print a range of bytes (inclusive) as hex, or send them raw
+	 * after a "RAW <length>" line. Memory is read a word at a time.
+	 */
+	void dump(unsigned int addr1, unsigned int addr2, bool raw);
 
-		return rv;
-	}
+	/*
+	 * Set a range of bytes (inclusive) to one value
+	 */
+	void fill(unsigned int addr1, unsigned int addr2, unsigned char value);
 
 	/*
-	 * Write a byte to memory
+	 * Copy a range of bytes (inclusive) to another address,
+	 * the ranges may overlap
 	 */
-	void write(int address, char value) {
-		volatile char* ptr = (char*)address;
-		*ptr = value;
-	}
+	void copy(unsigned int addr1, unsigned int addr2, unsigned int dest);
 }
 
 #endif
@@ -0,0 +1,64 @@
+/*
+ * FILENAME:	MotionEngine.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "MotionEngine.hpp"
+#include "PWMOutput.hpp"
+#include "system.h"
+
+#include <stddef.h>
+#include <sys/alt_alarm.h>
+
+static alt_alarm alarm;
+static alt_u32 period;
+static ServoMotion* axes[2];
+// made by start, static objects in other files (CameraMount) set the
+// deadband and start the engine from their constructors, so nothing
+// here may wait on a constructor of its own
+static PWMOutput* output;
+static int deadband;
+
+/*
+ * Alarm callback, runs in the system clock interrupt
+ */
+static alt_u32 tick(void* context) {
+	// pan is wired to channel A, tilt to channel B
+	int pan = axes[0]->step();
+	int tilt = axes[1]->step();
+	output->set<PWMINDEX_A>(pan, axes[0]->isSettled());
+	output->set<PWMINDEX_B>(tilt, axes[1]->isSettled());
+	output->flush();
+	return period;
+}
+
+/*
+ * Start stepping the pan and tilt servos
+ */
+void MotionEngine::start(ServoMotion* pan, ServoMotion* tilt) {
+	if(axes[0] != NULL)
+		return;
+
+	static PWMOutput pwm(MYNEWPWMV2_0_BASE);
+	pwm.setDeadband(deadband);
+	output = &pwm;
+
+	axes[0] = pan;
+	axes[1] = tilt;
+
+	period = MOTION_PERIOD_MS * alt_ticks_per_second() / 1000;
+	if(period == 0)
+		period = 1;
+
+	alt_alarm_start(&alarm, period, tick, NULL);
+}
+
+/*
+ * Set the smallest change in PWM counts written to the servos
+ */
+void MotionEngine::setDeadband(int counts) {
+	deadband = counts;
+	if(output != NULL)
+		output->setDeadband(counts);
+}
@@ -0,0 +1,29 @@
+/*
+ * FILENAME:	MotionEngine.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef MOTIONENGINE_HPP
+#define MOTIONENGINE_HPP
+
+#include "ServoMotion.hpp"
+
+/*
+ * MotionEngine namespace, steps the servo motion profiles every
+ * MOTION_PERIOD_MS from an alarm on the system clock interrupt and
+ * writes both channels through one output stage
+ */
+namespace MotionEngine {
+	/*
+	 * Start stepping the pan and tilt servos
+	 */
+	void start(ServoMotion* pan, ServoMotion* tilt);
+
+	/*
+	 * Set the smallest change in PWM counts written to the servos
+	 */
+	void setDeadband(int counts);
+}
+
+#endif /* MOTIONENGINE_HPP */
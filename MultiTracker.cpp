@@ -0,0 +1,193 @@
+/*
+ * FILENAME:	MultiTracker.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "MultiTracker.hpp"
+
+#include <stddef.h>
+
+// Farthest a blob can be from a prediction and still belong to it (pixels)
+#define GATE 10.0f
+#define GATE_SQ (GATE*GATE)
+
+// Frames a track survives without a blob
+#define MAX_MISSES 5
+
+// Frames a track needs before it can drive the servos
+#define CONFIRM_AGE 3
+
+// Velocity follows the measured motion at this rate
+#define VEL_GAIN 0.5f
+
+/*
+ * Constructor, pool starts empty
+ */
+MultiTracker::MultiTracker() {
+	policy = SELECT_LARGEST;
+	nextId = 0;
+	reset();
+}
+
+/*
+ * Drop every track
+ */
+void MultiTracker::reset() {
+	for(int i = 0; i < MAX_TRACKS; i++)
+		tracks[i].active = false;
+	selected = -1;
+}
+
+/*
+ * Associate a frame's blobs with the tracks, greedily pairing the
+ * closest blob and predicted track inside the gate first
+ */
+void MultiTracker::update(const Blob* blobs, int nBlobs) {
+	bool trackUsed[MAX_TRACKS];
+	bool blobUsed[MAX_BLOBS];
+
+	// predict where every track is this frame
+	for(int t = 0; t < MAX_TRACKS; t++) {
+		trackUsed[t] = !tracks[t].active;
+		if(tracks[t].active) {
+			tracks[t].row += tracks[t].velRow;
+			tracks[t].col += tracks[t].velCol;
+		}
+	}
+	for(int b = 0; b < nBlobs; b++)
+		blobUsed[b] = false;
+
+	while(true) {
+		int bestT = -1;
+		int bestB = -1;
+		float bestD = GATE_SQ;
+
+		for(int t = 0; t < MAX_TRACKS; t++) {
+			if(trackUsed[t])
+				continue;
+			for(int b = 0; b < nBlobs; b++) {
+				if(blobUsed[b])
+					continue;
+				float dr = blobs[b].row - tracks[t].row;
+				float dc = blobs[b].col - tracks[t].col;
+				float d = dr*dr + dc*dc;
+				if(d < bestD) {
+					bestD = d;
+					bestT = t;
+					bestB = b;
+				}
+			}
+		}
+
+		if(bestT < 0)
+			break;
+
+		// correct the prediction with the measurement
+		Track* tr = &tracks[bestT];
+		const Blob* bl = &blobs[bestB];
+		tr->velRow += VEL_GAIN * (bl->row - tr->row);
+		tr->velCol += VEL_GAIN * (bl->col - tr->col);
+		tr->row = bl->row;
+		tr->col = bl->col;
+		tr->size = bl->count;
+		tr->age++;
+		tr->misses = 0;
+
+		trackUsed[bestT] = true;
+		blobUsed[bestB] = true;
+	}
+
+	// tracks without a blob coast on their prediction for a few frames
+	for(int t = 0; t < MAX_TRACKS; t++) {
+		if(tracks[t].active && !trackUsed[t] && ++tracks[t].misses > MAX_MISSES) {
+			tracks[t].active = false;
+			if(selected == t)
+				selected = -1;
+		}
+	}
+
+	// blobs without a track start new ones in free slots
+	for(int b = 0; b < nBlobs; b++) {
+		if(blobUsed[b])
+			continue;
+		for(int t = 0; t < MAX_TRACKS; t++) {
+			if(tracks[t].active)
+				continue;
+			Track* tr = &tracks[t];
+			tr->active = true;
+			tr->id = nextId++;
+			tr->row = blobs[b].row;
+			tr->col = blobs[b].col;
+			tr->velRow = 0.0f;
+			tr->velCol = 0.0f;
+			tr->size = blobs[b].count;
+			tr->age = 1;
+			tr->misses = 0;
+			break;
+		}
+	}
+}
+
+/*
+ * Choose the confirmed track the policy prefers, -1 if none
+ */
+int MultiTracker::choose(float centerRow, float centerCol) {
+	int best = -1;
+	float bestScore = 0.0f;
+
+	for(int t = 0; t < MAX_TRACKS; t++) {
+		Track* tr = &tracks[t];
+		if(!tr->active || tr->age < CONFIRM_AGE)
+			continue;
+
+		float score;
+		switch(policy) {
+		case SELECT_OLDEST:
+			score = (float)tr->age;
+			break;
+		case SELECT_CENTER: {
+			float dr = tr->row - centerRow;
+			float dc = tr->col - centerCol;
+			score = -(dr*dr + dc*dc);
+			break;
+		}
+		default:
+			score = (float)tr->size;
+			break;
+		}
+
+		if(best < 0 || score > bestScore) {
+			best = t;
+			bestScore = score;
+		}
+	}
+
+	return best;
+}
+
+/*
+ * Get the track driving the servos, keeping the previous one while
+ * it lives, NULL if no track is confirmed
+ */
+Track* MultiTracker::select(float centerRow, float centerCol) {
+	if(selected < 0)
+		selected = choose(centerRow, centerCol);
+
+	return selected < 0 ? NULL : &tracks[selected];
+}
+
+/*
+ * Set which track is chosen when the driving track is lost
+ */
+void MultiTracker::setPolicy(SelectPolicy policy) {
+	this->policy = policy;
+	selected = -1;
+}
+
+/*
+ * Get a slot of the track pool
+ */
+Track* MultiTracker::get(int index) {
+	return &tracks[index];
+}
@@ -0,0 +1,83 @@
+/*
+ * FILENAME:	MultiTracker.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef MULTITRACKER_HPP
+#define MULTITRACKER_HPP
+
+#include "Blob.hpp"
+#include "SelectPolicy.h"
+
+// Size of the track pool
+#define MAX_TRACKS 8
+
+/*
+ * Track struct, state of one target followed across frames
+ */
+struct Track {
+	bool active;
+	int id;
+	float row;
+	float col;
+	float velRow;
+	float velCol;
+	int size;
+	int age;
+	int misses;
+};
+
+/*
+ * MultiTracker class, keeps the identity of every target in view
+ * by associating each frame's blobs with existing tracks
+ */
+class MultiTracker {
+private:
+	Track tracks[MAX_TRACKS];
+	SelectPolicy policy;
+	int selected;
+	int nextId;
+
+	/*
+	 * Choose the confirmed track the policy prefers, -1 if none
+	 */
+	int choose(float centerRow, float centerCol);
+
+protected:
+
+public:
+	/*
+	 * Constructor, pool starts empty
+	 */
+	MultiTracker();
+
+	/*
+	 * Drop every track
+	 */
+	void reset();
+
+	/*
+	 * Associate a frame's blobs with the tracks, greedily pairing the
+	 * closest blob and predicted track inside the gate first
+	 */
+	void update(const Blob* blobs, int nBlobs);
+
+	/*
+	 * Get the track driving the servos, keeping the previous one while
+	 * it lives, NULL if no track is confirmed
+	 */
+	Track* select(float centerRow, float centerCol);
+
+	/*
+	 * Set which track is chosen when the driving track is lost
+	 */
+	void setPolicy(SelectPolicy policy);
+
+	/*
+	 * Get a slot of the track pool
+	 */
+	Track* get(int index);
+};
+
+#endif /* MULTITRACKER_HPP */
@@ -0,0 +1,54 @@
+/*
+ * FILENAME:	Onchip.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef ONCHIP_H
+#define ONCHIP_H
+
+#ifdef __nios2__
+#include "system.h"
+#else
+// host builds of the tracker (see host/) have no BSP, use the
+// board's cache lines
+#define ALT_CPU_DCACHE_LINE_SIZE 32
+#define ALT_CPU_ICACHE_LINE_SIZE 32
+#endif
+
+/*
+ * Placement of hot data and code. ONCHIP_MEMORY2_0 holds the VGA frame
+ * in its first VGA_ROWS<<VGA_ROW_SHIFT bytes, the 512 bytes after it
+ * are free. Objects marked ONCHIP are linked there by onchip.x, add it
+ * to the application link (APP_LDFLAGS += -T onchip.x). They are still
+ * reached through the data cache, but a miss is a single on-chip read
+ * instead of an SDRAM burst.
+ */
+
+// Free space after the VGA frame
+#define ONCHIP_SPARE_BASE (ONCHIP_MEMORY2_0_BASE + 0x1E00)
+#define ONCHIP_SPARE_SIZE 512
+
+#ifdef __nios2__
+#define ONCHIP __attribute__((section(".onchip_spare")))
+#else
+#define ONCHIP
+#endif
+
+// Analysis scratch kept outside the objects that use it. The board
+// analyzes one frame at a time, host tools (see host/) analyze on
+// several threads at once and give each thread its own copy
+#ifdef __nios2__
+#define SCRATCH
+#else
+#define SCRATCH thread_local
+#endif
+
+// Data starting on its own data cache line
+#define CACHE_ALIGNED __attribute__((aligned(ALT_CPU_DCACHE_LINE_SIZE)))
+
+// Kernels starting on an instruction cache line, so their loops
+// span as few lines as possible
+#define HOT __attribute__((aligned(ALT_CPU_ICACHE_LINE_SIZE), hot))
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * FILENAME:	Overlay.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Overlay.hpp"
+#include "Camera.hpp"
+#include "Math.hpp"
+
+#include <stddef.h>
+
+// Kinds of shape
+#define SHAPE_BOX 0
+#define SHAPE_CROSS 1
+#define SHAPE_TEXT 2
+
+// Crosshair arm length, pixels
+#define CROSS_ARM 3
+
+// Character cell, each glyph row is one word of the frame
+#define GLYPH_ROWS 5
+#define GLYPH_WIDTH 4
+
+// 3x5 glyphs for digits and capitals, one row of three bits
+// (leftmost pixel in bit 2) per entry
+static const unsigned char digits[10][GLYPH_ROWS] = {
+	{ 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 }, { 7, 1, 3, 1, 7 }, { 5, 5, 7, 1, 1 },
+	{ 7, 4, 7, 1, 7 }, { 7, 4, 7, 5, 7 }, { 7, 1, 2, 2, 2 }, { 7, 5, 7, 5, 7 }, { 7, 5, 7, 1, 7 }
+};
+static const unsigned char letters[26][GLYPH_ROWS] = {
+	{ 2, 5, 7, 5, 5 }, { 6, 5, 6, 5, 6 }, { 3, 4, 4, 4, 3 }, { 6, 5, 5, 5, 6 }, { 7, 4, 6, 4, 7 },
+	{ 7, 4, 6, 4, 4 }, { 3, 4, 5, 5, 3 }, { 5, 5, 7, 5, 5 }, { 7, 2, 2, 2, 7 }, { 1, 1, 1, 5, 2 },
+	{ 5, 5, 6, 5, 5 }, { 4, 4, 4, 4, 7 }, { 5, 7, 7, 5, 5 }, { 6, 5, 5, 5, 5 }, { 2, 5, 5, 5, 2 },
+	{ 6, 5, 6, 4, 4 }, { 2, 5, 5, 6, 3 }, { 6, 5, 6, 5, 5 }, { 3, 4, 2, 1, 6 }, { 7, 2, 2, 2, 2 },
+	{ 5, 5, 5, 5, 7 }, { 5, 5, 5, 5, 2 }, { 5, 5, 7, 7, 5 }, { 5, 5, 2, 5, 5 }, { 5, 5, 2, 2, 2 },
+	{ 7, 1, 2, 4, 7 }
+};
+static const unsigned char blank[GLYPH_ROWS] = { 0, 0, 0, 0, 0 };
+static const unsigned char dash[GLYPH_ROWS] = { 0, 0, 7, 0, 0 };
+static const unsigned char dot[GLYPH_ROWS] = { 0, 0, 0, 0, 2 };
+
+/*
+ * Get the glyph for a character, anything without one is blank
+ */
+static const unsigned char* glyph(char ch) {
+	if(ch >= '0' && ch <= '9')
+		return digits[ch - '0'];
+	if(ch >= 'A' && ch <= 'Z')
+		return letters[ch - 'A'];
+	if(ch >= 'a' && ch <= 'z')
+		return letters[ch - 'a'];
+	if(ch == '-')
+		return dash;
+	if(ch == '.')
+		return dot;
+	return blank;
+}
+
+/*
+ * Fill columns col to colEnd (exclusive) of a row, whole words at a
+ * time where the span covers them
+ */
+static void span(volatile unsigned char* row, int col, int colEnd, unsigned char shade) {
+	unsigned int word = shade * 0x01010101u;
+
+	while(col < colEnd && (col & 3) != 0)
+		row[col++] = shade;
+	for(; col + 4 <= colEnd; col += 4)
+		*(volatile unsigned int*)(row + col) = word;
+	while(col < colEnd)
+		row[col++] = shade;
+}
+
+/*
+ * Constructor, overlay starts enabled and empty
+ */
+Overlay::Overlay() {
+	count = 0;
+	textUsed = 0;
+	enabled = true;
+	view = false;
+}
+
+/*
+ * Turn drawing on or off, shapes are still accepted when off
+ */
+void Overlay::enable(bool on) {
+	enabled = on;
+}
+
+/*
+ * Check whether the overlay is drawn
+ */
+bool Overlay::isEnabled() {
+	return enabled;
+}
+
+/*
+ * Add a shape to the list, returns NULL if the list is full
+ */
+Overlay::Shape* Overlay::add(unsigned char kind, unsigned char shade) {
+	if(count >= OVERLAY_SHAPES)
+		return NULL;
+
+	Shape* s = &shapes[count++];
+	s->kind = kind;
+	s->shade = shade;
+	return s;
+}
+
+/*
+ * Outline a box, corners inclusive
+ */
+void Overlay::box(int ulr, int ulc, int lrr, int lrc, unsigned char shade) {
+	Shape* s = add(SHAPE_BOX, shade);
+	if(s == NULL)
+		return;
+
+	s->row = Math::clamp(Math::min(ulr, lrr), 0, VGA_ROWS-1);
+	s->col = Math::clamp(Math::min(ulc, lrc), 0, VGA_COLUMNS-1);
+	s->rowEnd = Math::clamp(Math::max(ulr, lrr), 0, VGA_ROWS-1);
+	s->colEnd = Math::clamp(Math::max(ulc, lrc), 0, VGA_COLUMNS-1);
+}
+
+/*
+ * Mark a point with a crosshair
+ */
+void Overlay::cross(int row, int col, unsigned char shade) {
+	Shape* s = add(SHAPE_CROSS, shade);
+	if(s == NULL)
+		return;
+
+	s->row = Math::clamp(row, 0, VGA_ROWS-1);
+	s->col = Math::clamp(col, 0, VGA_COLUMNS-1);
+}
+
+/*
+ * Write a line of text with its top left at a point, the column
+ * is rounded down to a word, characters are 3x5 pixels on a dark
+ * cell four pixels wide
+ */
+void Overlay::print(int row, int col, const char* str, unsigned char shade) {
+	int first = textUsed;
+	while(*str != '\0' && textUsed < OVERLAY_TEXT)
+		text[textUsed++] = *(str++);
+
+	Shape* s = add(SHAPE_TEXT, shade);
+	if(s == NULL)
+		return;
+
+	s->row = Math::clamp(row, 0, VGA_ROWS-GLYPH_ROWS);
+	s->col = Math::clamp(col, 0, VGA_COLUMNS-1) & ~3;
+	s->first = first;
+	s->length = textUsed - first;
+}
+
+/*
+ * Show a region as black and white around a threshold
+ */
+void Overlay::threshold(int rowStart, int rowEnd, int colStart, int colEnd, unsigned char level) {
+	view = true;
+	viewRegion.shade = level;
+	viewRegion.row = Math::clamp(rowStart, 0, VGA_ROWS);
+	viewRegion.rowEnd = Math::clamp(rowEnd, 0, VGA_ROWS);
+	viewRegion.col = Math::clamp(colStart, 0, VGA_COLUMNS);
+	viewRegion.colEnd = Math::clamp(colEnd, 0, VGA_COLUMNS);
+}
+
+/*
+ * Draw everything recorded into a frame and start a new list
+ */
+void Overlay::render(volatile unsigned char* frame) {
+	if(enabled && view) {
+		const unsigned char level = viewRegion.shade;
+		for(int r = viewRegion.row; r < viewRegion.rowEnd; r++) {
+			volatile unsigned char* row = frame + (r << VGA_ROW_SHIFT);
+			int c = viewRegion.col;
+			int end = viewRegion.colEnd;
+
+			while(c < end && (c & 3) != 0) {
+				row[c] = row[c] < level ? 0 : 255;
+				c++;
+			}
+			// four pixels per read and write
+			for(; c + 4 <= end; c += 4) {
+				unsigned int w = *(volatile unsigned int*)(row + c);
+				unsigned int out = 0;
+				for(int k = 0; k < 32; k += 8)
+					if(((w >> k) & 0xFF) >= level)
+						out |= 0xFFu << k;
+				*(volatile unsigned int*)(row + c) = out;
+			}
+			while(c < end) {
+				row[c] = row[c] < level ? 0 : 255;
+				c++;
+			}
+		}
+	}
+
+	for(int i = 0; enabled && i < count; i++) {
+		const Shape* s = &shapes[i];
+
+		if(s->kind == SHAPE_BOX) {
+			span(frame + (s->row << VGA_ROW_SHIFT), s->col, s->colEnd + 1, s->shade);
+			span(frame + (s->rowEnd << VGA_ROW_SHIFT), s->col, s->colEnd + 1, s->shade);
+			for(int r = s->row + 1; r < s->rowEnd; r++) {
+				frame[(r << VGA_ROW_SHIFT) | s->col] = s->shade;
+				frame[(r << VGA_ROW_SHIFT) | s->colEnd] = s->shade;
+			}
+		} else if(s->kind == SHAPE_CROSS) {
+			span(frame + (s->row << VGA_ROW_SHIFT), Math::max(s->col - CROSS_ARM, 0),
+					Math::min(s->col + CROSS_ARM + 1, VGA_COLUMNS), s->shade);
+			int rowEnd = Math::min(s->row + CROSS_ARM, VGA_ROWS-1);
+			for(int r = Math::max(s->row - CROSS_ARM, 0); r <= rowEnd; r++)
+				frame[(r << VGA_ROW_SHIFT) | s->col] = s->shade;
+		} else {
+			// one word per glyph row, the fourth pixel is the gap
+			const char* str = text + s->first;
+			int n = Math::min((int)s->length, (VGA_COLUMNS - s->col) / GLYPH_WIDTH);
+			for(int g = 0; g < n; g++) {
+				const unsigned char* bits = glyph(str[g]);
+				volatile unsigned char* cell = frame + (s->row << VGA_ROW_SHIFT) + s->col + g*GLYPH_WIDTH;
+				for(int r = 0; r < GLYPH_ROWS; r++) {
+					unsigned int word = 0;
+					if(bits[r] & 4)
+						word |= s->shade;
+					if(bits[r] & 2)
+						word |= s->shade << 8;
+					if(bits[r] & 1)
+						word |= s->shade << 16;
+					*(volatile unsigned int*)(cell + (r << VGA_ROW_SHIFT)) = word;
+				}
+			}
+		}
+	}
+
+	clear();
+}
+
+/*
+ * Drop everything recorded without drawing it
+ */
+void Overlay::clear() {
+	count = 0;
+	textUsed = 0;
+	view = false;
+}
@@ -0,0 +1,104 @@
+/*
+ * FILENAME:	Overlay.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef OVERLAY_HPP
+#define OVERLAY_HPP
+
+#include "Blob.hpp"
+
+// Most shapes and text characters drawn over one frame: a box per blob
+// in MULTI mode, and the region of interest, its middle, the aim point
+// and the status line
+#define OVERLAY_SHAPES (MAX_BLOBS + 4)
+#define OVERLAY_TEXT 32
+
+/*
+ * Overlay class, tracking annotations for the VGA display. Shapes
+ * are only recorded while a frame is being analyzed and are drawn
+ * into the frame once analysis is done, so they never reach the
+ * tracker, and the next capture overwrites them. Horizontal runs
+ * are written a word (four pixels) at a time.
+ */
+class Overlay {
+private:
+	struct Shape {
+		unsigned char kind;
+		unsigned char shade;
+		unsigned char row;
+		unsigned char col;
+		unsigned char rowEnd;
+		unsigned char colEnd;
+		unsigned char first;
+		unsigned char length;
+	};
+
+	Shape shapes[OVERLAY_SHAPES];
+	int count;
+	char text[OVERLAY_TEXT];
+	int textUsed;
+	bool enabled;
+
+	// thresholded view of a region drawn under the shapes
+	bool view;
+	Shape viewRegion;
+
+	/*
+	 * Add a shape to the list, returns NULL if the list is full
+	 */
+	Shape* add(unsigned char kind, unsigned char shade);
+
+protected:
+
+public:
+	/*
+	 * Constructor, overlay starts enabled and empty
+	 */
+	Overlay();
+
+	/*
+	 * Turn drawing on or off, shapes are still accepted when off
+	 */
+	void enable(bool on);
+
+	/*
+	 * Check whether the overlay is drawn
+	 */
+	bool isEnabled();
+
+	/*
+	 * Outline a box, corners inclusive
+	 */
+	void box(int ulr, int ulc, int lrr, int lrc, unsigned char shade);
+
+	/*
+	 * Mark a point with a crosshair
+	 */
+	void cross(int row, int col, unsigned char shade);
+
+	/*
+	 * Write a line of text with its top left at a point, the column
+	 * is rounded down to a word, characters are 3x5 pixels on a dark
+	 * cell four pixels wide
+	 */
+	void print(int row, int col, const char* str, unsigned char shade);
+
+	/*
+	 * Show a region as black and white around a threshold
+	 */
+	void threshold(int rowStart, int rowEnd, int colStart, int colEnd, unsigned char level);
+
+	/*
+	 * Draw everything recorded into a frame and start a new list
+	 */
+	void render(volatile unsigned char* frame);
+
+	/*
+	 * Drop everything recorded without drawing it
+	 */
+	void clear();
+};
+
+#endif /* OVERLAY_HPP */
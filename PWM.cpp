@@ -11,7 +11,6 @@
 #include <io.h>
 #include <stdio.h>
 
-#define MAX_CNT 20000
 
 #define OFFSET_OCRA 0
 #define OFFSET_OCRB 2
@@ -34,9 +33,22 @@ PWM::PWM(int address, PWMIndex index, float dc) : address(address), index(index)
  */
 void PWM::setDC(volatile float dc) {
 	dc = Math::clamp<float>(dc, 0.0, 1.0);
+	setCount((int)(dc*PWM_MAX_COUNT));
+}
 
-	this->dc = dc;
-	volatile int count = (int)(dc*MAX_CNT);
+/*
+ * Gets the set duty cycle
+ */
+float PWM::getDC() {
+	return count * (1.0f / PWM_MAX_COUNT);
+}
+
+/*
+ * Sets duty cycle as a count out of PWM_MAX_COUNT, without
+ * floating point so it can be called from an interrupt
+ */
+void PWM::setCount(int count) {
+	this->count = count;
 
 	//volatile short* ptr;
 
@@ -55,8 +67,8 @@ void PWM::setDC(volatile float dc) {
 }
 
 /*
- * Gets the set duty cycle
+ * Gets the set duty cycle as a count
  */
-float PWM::getDC() {
-	return dc;
+int PWM::getCount() {
+	return count;
 }
@@ -9,12 +9,15 @@
 
 #include "PWMIndex.h"
 
+// Counts in one PWM period
+#define PWM_MAX_COUNT 20000
+
 /*
  * PWM class, controls one half of a PWM component
  */
 class PWM {
 private:
-	float dc;
+	int count;
 	int address;
 	PWMIndex index;
 
@@ -43,6 +46,17 @@ public:
 	 */
 	float getDC();
 
+	/*
+	 * Sets duty cycle as a count out of PWM_MAX_COUNT, without
+	 * floating point so it can be called from an interrupt
+	 */
+	void setCount(int count);
+
+	/*
+	 * Gets the set duty cycle as a count
+	 */
+	int getCount();
+
 };
 
 #endif
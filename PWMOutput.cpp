@@ -0,0 +1,60 @@
+/*
+ * FILENAME:	PWMOutput.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "PWMOutput.hpp"
+#include "Math.hpp"
+
+#include <io.h>
+
+// OCRA and OCRB are adjacent halves of the first register word
+#define OFFSET_OCRA 0
+#define OFFSET_OCRB 2
+
+// Nothing written yet, any staged count differs from this
+#define UNWRITTEN (-0x10000)
+
+/*
+ * Constructor, base address of the PWM component
+ */
+PWMOutput::PWMOutput(int address) : address(address), deadband(0) {
+	staged[PWMINDEX_A] = written[PWMINDEX_A] = UNWRITTEN;
+	staged[PWMINDEX_B] = written[PWMINDEX_B] = UNWRITTEN;
+	ending[PWMINDEX_A] = ending[PWMINDEX_B] = false;
+}
+
+/*
+ * Set the smallest change in counts that is written
+ */
+void PWMOutput::setDeadband(int counts) {
+	deadband = counts;
+}
+
+/*
+ * Write the staged counts that moved out of the deadband or are
+ * final, with one bus write when both channels changed
+ */
+void PWMOutput::flush() {
+	int a = staged[PWMINDEX_A];
+	int b = staged[PWMINDEX_B];
+	// the deadband only skips steps on the way, the last one always lands
+	int moveA = Math::abs(a - written[PWMINDEX_A]);
+	int moveB = Math::abs(b - written[PWMINDEX_B]);
+	bool changeA = a != UNWRITTEN && (moveA > deadband || (ending[PWMINDEX_A] && moveA != 0));
+	bool changeB = b != UNWRITTEN && (moveB > deadband || (ending[PWMINDEX_B] && moveB != 0));
+
+	if(changeA && changeB) {
+		// little endian, OCRA is the low half
+		IOWR_32DIRECT(address, OFFSET_OCRA, (a & 0xFFFF) | (b << 16));
+		written[PWMINDEX_A] = a;
+		written[PWMINDEX_B] = b;
+	} else if(changeA) {
+		IOWR_16DIRECT(address, OFFSET_OCRA, a);
+		written[PWMINDEX_A] = a;
+	} else if(changeB) {
+		IOWR_16DIRECT(address, OFFSET_OCRB, b);
+		written[PWMINDEX_B] = b;
+	}
+}
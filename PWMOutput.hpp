@@ -0,0 +1,63 @@
+/*
+ * FILENAME:	PWMOutput.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PWMOUTPUT_HPP
+#define PWMOUTPUT_HPP
+
+#include "PWMIndex.h"
+
+/*
+ * PWMOutput class, output stage of a two channel PWM component. Counts
+ * are staged per channel and written together by flush, changes within
+ * the deadband of the last written count are dropped unless the count
+ * is where the motion ends.
+ */
+class PWMOutput {
+private:
+	int address;
+	int deadband;
+	int staged[2];
+	bool ending[2];
+	int written[2];
+
+protected:
+
+public:
+	/*
+	 * Constructor, base address of the PWM component
+	 */
+	PWMOutput(int address);
+
+	/*
+	 * Stage the count of a channel chosen at compile time, a final
+	 * count (the motion has reached its target) is written however
+	 * little it differs
+	 */
+	template <PWMIndex INDEX> void set(int count, bool last) {
+		staged[INDEX] = count;
+		ending[INDEX] = last;
+	}
+
+	/*
+	 * Get the count last written to a channel
+	 */
+	template <PWMIndex INDEX> int get() {
+		return written[INDEX];
+	}
+
+	/*
+	 * Set the smallest change in counts that is written
+	 */
+	void setDeadband(int counts);
+
+	/*
+	 * Write the staged counts that moved out of the deadband or are
+	 * final, with one bus write when both channels changed
+	 */
+	void flush();
+};
+
+#endif /* PWMOUTPUT_HPP */
@@ -0,0 +1,129 @@
+/*
+ * FILENAME:	PanTilt.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "PanTilt.hpp"
+#include "Math.hpp"
+
+// Servo input boundaries
+#define INPUT_MIN 0.0f
+#define INPUT_MAX 1.0f
+
+// Servo travel during a frame that still leaves it sharp enough to
+// act on, PWM counts (about a pixel)
+#define MOUNT_STILL_COUNTS 6
+
+/*
+ * Constructor, pan on channel A and tilt on channel B, limits
+ * and servo deadtime come from the parameters
+ */
+PanTilt::PanTilt(const TrackerParams* params) : servoPan(PWMINDEX_A), servoTilt(PWMINDEX_B) {
+	this->params = params;
+	lastPan = 0.0f;
+	lastTilt = 0.0f;
+	frameSteady = false;
+	framePan = 0.0f;
+	frameTilt = 0.0f;
+}
+
+/*
+ * Set the pan servo to a position specified by degrees
+ */
+void PanTilt::pan(float degrees) {
+	float value = Math::scale<float>(degrees, -90.0f, 90.0f, params->panMin, params->panMax);
+	servoPan.setLimits(params->panMin, params->panMax);
+	servoPan.setTarget(Math::clamp<float>(value, params->panMin, params->panMax));
+	lastPan = panDegrees(servoPan.getTarget());
+}
+
+/*
+ * Set the tilt servo to a position specified by degrees
+ */
+void PanTilt::tilt(float degrees) {
+	float value = Math::scale<float>(degrees, 0.0f, 90.0f, 0.0f, 0.65f);
+	servoTilt.setLimits(params->tiltMin, params->tiltMax);
+	servoTilt.setTarget(Math::clamp<float>(Math::scale<float>(value, INPUT_MIN, INPUT_MAX, params->tiltMin, params->tiltMax), params->tiltMin, params->tiltMax));
+	lastTilt = tiltDegrees(servoTilt.getTarget());
+}
+
+/*
+ * Get the positions last commanded, degrees
+ */
+float PanTilt::getPan() {
+	return lastPan;
+}
+
+float PanTilt::getTilt() {
+	return lastTilt;
+}
+
+/*
+ * Convert a pan servo duty cycle to degrees
+ */
+float PanTilt::panDegrees(float dc) {
+	return Math::scale<float>(dc, params->panMin, params->panMax, -90.0f, 90.0f);
+}
+
+/*
+ * Convert a tilt servo duty cycle to degrees
+ */
+float PanTilt::tiltDegrees(float dc) {
+	float value = Math::scale<float>(dc, params->tiltMin, params->tiltMax, INPUT_MIN, INPUT_MAX);
+	return Math::scale<float>(value, 0.0f, 0.65f, 0.0f, 90.0f);
+}
+
+/*
+ * Get the servos, to be stepped by the motion engine
+ */
+ServoMotion* PanTilt::getPanServo() {
+	return &servoPan;
+}
+
+ServoMotion* PanTilt::getTiltServo() {
+	return &servoTilt;
+}
+
+/*
+ * Get the number of the last profile step, both servos
+ * are stepped together
+ */
+unsigned int PanTilt::getStep() {
+	return servoPan.getStep();
+}
+
+/*
+ * Estimate where the mount was while a frame was read out between
+ * two profile steps: the profile output, late by the servo deadtime
+ */
+void PanTilt::placeFrame(unsigned int from, unsigned int to) {
+	unsigned int delay = params->servoDeadtime / MOTION_PERIOD_MS;
+	from -= delay;
+	to -= delay;
+
+	// a frame taken while the mount slewed is smeared, and shows the
+	// target where the mount was rather than where it is going
+	frameSteady = servoPan.travel(from, to) <= MOUNT_STILL_COUNTS &&
+			servoTilt.travel(from, to) <= MOUNT_STILL_COUNTS;
+
+	unsigned int mid = from + (to - from) / 2;
+	framePan = panDegrees(servoPan.countAt(mid) * (1.0f / PWM_MAX_COUNT));
+	frameTilt = tiltDegrees(servoTilt.countAt(mid) * (1.0f / PWM_MAX_COUNT));
+}
+
+/*
+ * Get whether the mount held still through the frame placed last,
+ * and where it pointed, degrees
+ */
+bool PanTilt::isSteady() {
+	return frameSteady;
+}
+
+float PanTilt::getFramePan() {
+	return framePan;
+}
+
+float PanTilt::getFrameTilt() {
+	return frameTilt;
+}
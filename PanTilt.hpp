@@ -0,0 +1,87 @@
+/*
+ * FILENAME:	PanTilt.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PANTILT_HPP
+#define PANTILT_HPP
+
+#include "ServoMotion.hpp"
+#include "Params.hpp"
+
+/*
+ * PanTilt class, the two servos that point the camera, commanded
+ * in degrees, and where they were while a frame was taken
+ */
+class PanTilt {
+private:
+	ServoMotion servoPan;
+	ServoMotion servoTilt;
+	const TrackerParams* params;
+	float lastPan;
+	float lastTilt;
+	bool frameSteady;
+	float framePan;
+	float frameTilt;
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, pan on channel A and tilt on channel B, limits
+	 * and servo deadtime come from the parameters
+	 */
+	PanTilt(const TrackerParams* params);
+
+	/*
+	 * Set the pan servo to a position specified by degrees
+	 */
+	void pan(float degrees);
+
+	/*
+	 * Set the tilt servo to a position specified by degrees
+	 */
+	void tilt(float degrees);
+
+	/*
+	 * Get the positions last commanded, degrees
+	 */
+	float getPan();
+	float getTilt();
+
+	/*
+	 * Convert a servo duty cycle to degrees
+	 */
+	float panDegrees(float dc);
+	float tiltDegrees(float dc);
+
+	/*
+	 * Get the servos, to be stepped by the motion engine
+	 */
+	ServoMotion* getPanServo();
+	ServoMotion* getTiltServo();
+
+	/*
+	 * Get the number of the last profile step, both servos
+	 * are stepped together
+	 */
+	unsigned int getStep();
+
+	/*
+	 * Estimate where the mount was while a frame was read out between
+	 * two profile steps: the profile output, late by the servo deadtime
+	 */
+	void placeFrame(unsigned int from, unsigned int to);
+
+	/*
+	 * Get whether the mount held still through the frame placed last,
+	 * and where it pointed, degrees
+	 */
+	bool isSteady();
+	float getFramePan();
+	float getFrameTilt();
+};
+
+#endif /* PANTILT_HPP */
@@ -0,0 +1,149 @@
+/*
+ * FILENAME:	Params.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Params.hpp"
+#include "Camera.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+// Tilt servo boundaries
+#define TILT_MIN 0.02f
+#define TILT_MAX 0.10f
+
+// Pan servo boundaries
+#define PAN_MIN 0.025f
+#define PAN_MAX 0.12f
+
+#define ADJ_FACTOR_PAN (-0.5f)
+#define ADJ_FACTOR_TILT (0.6f)
+#define PXROW_TH_COLS 5
+#define PXROW_TH_ROWS 3
+
+#define ROW_START 18
+#define ROW_END 55
+#define COL_START 5
+#define COL_END 75
+
+#define SERVO_DEADBAND 2
+#define SERVO_DEADTIME 100
+
+/*
+ * ParamInfo struct, where a named field lives and what it may hold
+ */
+struct ParamInfo {
+	const char* name;
+	bool isFloat;
+	size_t offset;
+	float min;
+	float max;
+};
+
+#define FIELD(f) offsetof(TrackerParams, f)
+
+static const ParamInfo info[] = {
+	{ "ADJ_PAN", true, FIELD(adjPan), -10.0f, 10.0f },
+	{ "ADJ_TILT", true, FIELD(adjTilt), -10.0f, 10.0f },
+	{ "PXROW_COLS", false, FIELD(pxrowCols), 0, VGA_COLUMNS },
+	{ "PXROW_ROWS", false, FIELD(pxrowRows), 0, VGA_ROWS },
+	{ "ROW_START", false, FIELD(rowStart), 1, VGA_ROWS-1 },
+	{ "ROW_END", false, FIELD(rowEnd), 1, VGA_ROWS-1 },
+	{ "COL_START", false, FIELD(colStart), 1, VGA_COLUMNS-1 },
+	{ "COL_END", false, FIELD(colEnd), 1, VGA_COLUMNS-1 },
+	{ "PAN_MIN", true, FIELD(panMin), 0.0f, 1.0f },
+	{ "PAN_MAX", true, FIELD(panMax), 0.0f, 1.0f },
+	{ "TILT_MIN", true, FIELD(tiltMin), 0.0f, 1.0f },
+	{ "TILT_MAX", true, FIELD(tiltMax), 0.0f, 1.0f },
+	{ "SERVO_DEADBAND", false, FIELD(servoDeadband), 0, 50 },
+	{ "SERVO_DEADTIME", false, FIELD(servoDeadtime), 0, 1000 }
+};
+
+#define PARAM_COUNT (sizeof(info)/sizeof(info[0]))
+
+/*
+ * Find a field by name, NULL if unknown
+ */
+static const ParamInfo* find(const char* name) {
+	for(unsigned int i = 0; i < PARAM_COUNT; i++) {
+		if(strcmp(name, info[i].name) == 0)
+			return &info[i];
+	}
+	return NULL;
+}
+
+/*
+ * Fill a block with the built-in defaults
+ */
+void Params::defaults(TrackerParams* p) {
+	p->adjPan = ADJ_FACTOR_PAN;
+	p->adjTilt = ADJ_FACTOR_TILT;
+	p->pxrowCols = PXROW_TH_COLS;
+	p->pxrowRows = PXROW_TH_ROWS;
+	p->rowStart = ROW_START;
+	p->rowEnd = ROW_END;
+	p->colStart = COL_START;
+	p->colEnd = COL_END;
+	p->panMin = PAN_MIN;
+	p->panMax = PAN_MAX;
+	p->tiltMin = TILT_MIN;
+	p->tiltMax = TILT_MAX;
+	p->servoDeadband = SERVO_DEADBAND;
+	p->servoDeadtime = SERVO_DEADTIME;
+}
+
+/*
+ * Set a field by name, returns false if the name is unknown or
+ * the value would leave the block inconsistent
+ */
+bool Params::set(TrackerParams* p, const char* name, float value) {
+	const ParamInfo* pi = find(name);
+	if(pi == NULL || value < pi->min || value > pi->max)
+		return false;
+
+	// change a copy so a bad combination never reaches the tracker
+	TrackerParams next = *p;
+	char* field = (char*)&next + pi->offset;
+	if(pi->isFloat)
+		*(float*)field = value;
+	else
+		*(int*)field = (int)value;
+
+	if(next.rowStart >= next.rowEnd || next.colStart >= next.colEnd)
+		return false;
+	if(next.panMin >= next.panMax || next.tiltMin >= next.tiltMax)
+		return false;
+
+	*p = next;
+	return true;
+}
+
+/*
+ * Get a field by name, returns false if the name is unknown
+ */
+bool Params::get(const TrackerParams* p, const char* name, float* value) {
+	const ParamInfo* pi = find(name);
+	if(pi == NULL)
+		return false;
+
+	const char* field = (const char*)p + pi->offset;
+	*value = pi->isFloat ? *(const float*)field : (float)*(const int*)field;
+	return true;
+}
+
+/*
+ * Print every field as a SET command
+ */
+void Params::print(const TrackerParams* p) {
+	for(unsigned int i = 0; i < PARAM_COUNT; i++) {
+		float value;
+		get(p, info[i].name, &value);
+		if(info[i].isFloat)
+			printf("SET %s %f\n", info[i].name, value);
+		else
+			printf("SET %s %d\n", info[i].name, (int)value);
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ * FILENAME:	Params.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PARAMS_HPP
+#define PARAMS_HPP
+
+/*
+ * TrackerParams struct, tuning of the tracker that can be
+ * changed while it runs
+ */
+struct TrackerParams {
+	// Degrees moved per pixel of error
+	float adjPan;
+	float adjTilt;
+
+	// Shortest runs counted as the target
+	int pxrowCols;
+	int pxrowRows;
+
+	// Region of interest
+	int rowStart;
+	int rowEnd;
+	int colStart;
+	int colEnd;
+
+	// Servo duty cycle boundaries
+	float panMin;
+	float panMax;
+	float tiltMin;
+	float tiltMax;
+
+	// Smallest change in PWM counts sent to the servos
+	int servoDeadband;
+
+	// Time from a servo command until the image starts to move, ms
+	int servoDeadtime;
+};
+
+/*
+ * Params namespace, accesses the fields of a parameter block by name
+ */
+namespace Params {
+	/*
+	 * Fill a block with the built-in defaults
+	 */
+	void defaults(TrackerParams* p);
+
+	/*
+	 * Set a field by name, returns false if the name is unknown or
+	 * the value would leave the block inconsistent
+	 */
+	bool set(TrackerParams* p, const char* name, float value);
+
+	/*
+	 * Get a field by name, returns false if the name is unknown
+	 */
+	bool get(const TrackerParams* p, const char* name, float* value);
+
+	/*
+	 * Print every field as a SET command
+	 */
+	void print(const TrackerParams* p);
+}
+
+#endif /* PARAMS_HPP */
@@ -0,0 +1,184 @@
+/*
+ * FILENAME:	Preview.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Preview.hpp"
+#include "Camera.hpp"
+#include "Clock.hpp"
+
+#include <string.h>
+
+// Largest encoding of a frame, every pixel a literal
+#define PREVIEW_MAX (VGA_ROWS*VGA_COLUMNS + (VGA_ROWS*VGA_COLUMNS)/128 + 1)
+
+// Longest run a token can describe
+#define RUN_MAX 128
+
+// Frames sent between key frames, lets a viewer join or recover
+#define KEY_INTERVAL 16
+
+// Share of the link time the preview may use, percent
+#define LINK_SHARE 50
+
+// Encoded frame and the frame the viewer will reconstruct from it
+static unsigned char encoded[PREVIEW_MAX];
+static unsigned char previous[VGA_ROWS*VGA_COLUMNS];
+
+/*
+ * Constructor, chunks are sent over a shared link
+ */
+Preview::Preview(Link* link) : link(link), mode(PREVIEW_OFF), frameSeq(0), sinceKey(KEY_INTERVAL),
+		length(0), sent(0), chunkLength(0), chunkSent(0), nextAllowed(0) { }
+
+/*
+ * Choose what is streamed, the next frame sent is a key frame
+ */
+void Preview::setMode(PreviewMode mode) {
+	this->mode = mode;
+	sinceKey = KEY_INTERVAL;
+	nextAllowed = Clock::now();
+}
+
+/*
+ * Encode a frame if the link has finished the last one and has had
+ * time to carry other traffic, returns false if the frame was skipped
+ */
+bool Preview::offer(volatile unsigned char* frame, unsigned char threshold) {
+	unsigned int now = Clock::now();
+	if(mode == PREVIEW_OFF || length > 0 || (int)(now - nextAllowed) < 0)
+		return false;
+
+	bool key = sinceKey >= KEY_INTERVAL;
+	sinceKey = key ? 1 : sinceKey + 1;
+
+	flags = (key ? PREVIEW_KEY : 0) | (mode == PREVIEW_MASKED ? PREVIEW_MASK : 0);
+	if(key)
+		memset(previous, 0, sizeof(previous));
+
+	length = encode(frame, threshold);
+	sent = 0;
+	started = now;
+	return true;
+}
+
+/*
+ * Delta and run length code the frame, returns the encoded size
+ */
+int Preview::encode(volatile unsigned char* frame, unsigned char threshold) {
+	bool mask = (mode == PREVIEW_MASKED);
+	unsigned char* prev = previous;
+	int n = 0;
+	int zeros = 0;
+	int literals = 0;
+	int token = 0;
+
+	for(int r = 0; r < VGA_ROWS; r++) {
+		volatile unsigned char* px = frame + (r<<VGA_ROW_SHIFT);
+
+		for(int c = 0; c < VGA_COLUMNS; c++) {
+			unsigned char q;
+			if(mask)
+				q = px[c] > threshold ? PREVIEW_LEVELS-1 : 0;
+			else
+				q = px[c] >> (8 - PREVIEW_BITS);
+
+			unsigned char d = (q - *prev) & (PREVIEW_LEVELS-1);
+			*(prev++) = q;
+
+			if(d == 0) {
+				// close a literal run
+				if(literals > 0) {
+					encoded[token] = 0x80 | (literals - 1);
+					literals = 0;
+				}
+				if(++zeros == RUN_MAX) {
+					encoded[n++] = zeros - 1;
+					zeros = 0;
+				}
+			} else {
+				// close a zero run
+				if(zeros > 0) {
+					encoded[n++] = zeros - 1;
+					zeros = 0;
+				}
+				if(literals == 0)
+					token = n++;
+				encoded[n++] = d;
+				if(++literals == RUN_MAX) {
+					encoded[token] = 0x80 | (literals - 1);
+					literals = 0;
+				}
+			}
+		}
+	}
+
+	if(literals > 0)
+		encoded[token] = 0x80 | (literals - 1);
+	if(zeros > 0)
+		encoded[n++] = zeros - 1;
+
+	return n;
+}
+
+/*
+ * Prepare the next chunk of the encoded frame
+ */
+void Preview::nextChunk() {
+	PreviewHeader* h = (PreviewHeader*)chunk;
+	int data = length - sent;
+	if(data > PREVIEW_CHUNK_DATA)
+		data = PREVIEW_CHUNK_DATA;
+
+	h->sync = PREVIEW_SYNC;
+	h->frame = frameSeq;
+	h->flags = flags | (sent + data == length ? PREVIEW_LAST : 0);
+	h->offset = sent;
+	h->length = data;
+	h->check = 0;
+	memcpy(chunk + sizeof(PreviewHeader), encoded + sent, data);
+
+	unsigned char sum = 0;
+	for(unsigned int i = 0; i < sizeof(PreviewHeader) + data; i++)
+		sum += chunk[i];
+	h->check = -sum;
+
+	chunkLength = sizeof(PreviewHeader) + data;
+	chunkSent = 0;
+}
+
+/*
+ * Send as much of the encoded frame as the link takes right now
+ */
+void Preview::drain() {
+	while(length > 0) {
+		if(chunkLength == 0)
+			nextChunk();
+
+		int n = link->send(LINK_PREVIEW, chunk + chunkSent, chunkLength - chunkSent);
+
+		// link is full or busy, try again on the next pass of the main loop
+		if(n == 0)
+			return;
+
+		chunkSent += n;
+		if(chunkSent < chunkLength)
+			continue;
+
+		// chunk complete, other streams may go between chunks
+		link->release(LINK_PREVIEW);
+		sent += chunkLength - sizeof(PreviewHeader);
+		chunkLength = 0;
+
+		if(sent == length) {
+			// idle the link as long again as the frame took, so other
+			// traffic keeps its share however fast the link turns out to be,
+			// dividing first so a slow frame cannot overflow the product
+			unsigned int now = Clock::now();
+			nextAllowed = now + (now - started) / LINK_SHARE * (100 - LINK_SHARE);
+			frameSeq++;
+			length = 0;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+/*
+ * FILENAME:	Preview.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PREVIEW_HPP
+#define PREVIEW_HPP
+
+#include "PreviewChunk.h"
+#include "PreviewMode.h"
+#include "Link.hpp"
+
+/*
+ * Preview class, streams the VGA frame (or its thresholded mask)
+ * over the debug link, delta and run length coded, and only as
+ * often as the link can carry it
+ */
+class Preview {
+private:
+	Link* link;
+	PreviewMode mode;
+	unsigned char frameSeq;
+	unsigned char flags;
+	int sinceKey;
+
+	// encoded frame being sent
+	int length;
+	int sent;
+
+	// chunk being sent
+	unsigned char chunk[sizeof(PreviewHeader) + PREVIEW_CHUNK_DATA];
+	int chunkLength;
+	int chunkSent;
+
+	// rate limiting, Clock timestamps
+	unsigned int started;
+	unsigned int nextAllowed;
+
+	/*
+	 * Delta and run length code the frame, returns the encoded size
+	 */
+	int encode(volatile unsigned char* frame, unsigned char threshold);
+
+	/*
+	 * Prepare the next chunk of the encoded frame
+	 */
+	void nextChunk();
+
+protected:
+
+public:
+	/*
+	 * Constructor, chunks are sent over a shared link
+	 */
+	Preview(Link* link);
+
+	/*
+	 * Choose what is streamed, the next frame sent is a key frame
+	 */
+	void setMode(PreviewMode mode);
+
+	/*
+	 * Encode a frame if the link has finished the last one and has had
+	 * time to carry other traffic, returns false if the frame was skipped
+	 */
+	bool offer(volatile unsigned char* frame, unsigned char threshold);
+
+	/*
+	 * Send as much of the encoded frame as the link takes right now
+	 */
+	void drain();
+};
+
+#endif /* PREVIEW_HPP */
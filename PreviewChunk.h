@@ -0,0 +1,49 @@
+/*
+ * FILENAME:	PreviewChunk.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PREVIEWCHUNK_H
+#define PREVIEWCHUNK_H
+
+// First two bytes of every chunk, as sent (little endian)
+#define PREVIEW_SYNC 0x5BA5
+
+// Chunk flag bits
+#define PREVIEW_KEY (1<<0)
+#define PREVIEW_MASK (1<<1)
+#define PREVIEW_LAST (1<<2)
+
+// Most encoded bytes carried by one chunk
+#define PREVIEW_CHUNK_DATA 56
+
+// Pixels are sent with this many bits
+#define PREVIEW_BITS 6
+#define PREVIEW_LEVELS (1<<PREVIEW_BITS)
+
+/*
+ * Encoding of a frame, VGA_ROWS x VGA_COLUMNS pixels in VGA memory
+ * order. Each pixel is quantized to PREVIEW_BITS and sent as its
+ * difference from the same pixel of the previous frame (modulo
+ * PREVIEW_LEVELS), or from zero in a key frame. Differences are run
+ * length coded by a token byte:
+ *   0nnnnnnn  n+1 pixels are unchanged
+ *   1nnnnnnn  n+1 differences follow, one byte each
+ */
+
+/*
+ * PreviewHeader struct, precedes every chunk of an encoded frame
+ */
+struct PreviewHeader {
+	unsigned short sync;
+	unsigned char frame;		// frame sequence number
+	unsigned char flags;
+	unsigned short offset;		// of this chunk in the encoded frame
+	unsigned char length;		// encoded bytes following the header
+	unsigned char check;		// makes the header and data bytes sum to zero
+};
+
+typedef struct PreviewHeader PreviewHeader;
+
+#endif
@@ -0,0 +1,19 @@
+/*
+ * FILENAME:	PreviewMode.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PREVIEWMODE_H
+#define PREVIEWMODE_H
+
+/*
+ * PreviewMode enum, determines what the live preview streams
+ */
+enum PreviewMode {
+	PREVIEW_OFF, PREVIEW_FRAME, PREVIEW_MASKED
+};
+
+typedef enum PreviewMode PreviewMode;
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * FILENAME:	Pyramid.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Pyramid.hpp"
+#include "Onchip.h"
+
+// Line accumulators, added to twice per sampled pixel pair while
+// capturing, kept on chip so a cache miss never stalls the PCLK loop
+static unsigned short sums1[PYR1_COLUMNS] ONCHIP CACHE_ALIGNED;
+static unsigned short sums2[PYR2_COLUMNS] ONCHIP;
+
+/*
+ * Constructor, clears the line accumulators
+ */
+Pyramid::Pyramid() {
+	begin();
+}
+
+/*
+ * Prepare for a new frame
+ */
+void Pyramid::begin() {
+	for(int i = 0; i < PYR1_COLUMNS; i++)
+		sums1[i] = 0;
+	for(int i = 0; i < PYR2_COLUMNS; i++)
+		sums2[i] = 0;
+	line = 0;
+}
+
+/*
+ * Accumulators the capture loop adds horizontal pixel pairs into,
+ * index 0 is the first pair of the line as it leaves the sensor
+ */
+unsigned short* Pyramid::lineSums() {
+	return sums1;
+}
+
+/*
+ * Fold the accumulated line into the downsampled levels,
+ * called while the sensor sends a line that is not sampled
+ */
+void Pyramid::finishLine() {
+	// frame is stored rotated, the first line captured is the last VGA row
+	int l = line++;
+	if(l >= VGA_ROWS || (l&1) == 0)
+		return;
+
+	// two lines (four pixels per cell) are complete
+	unsigned char* out1 = level1[PYR1_ROWS-1 - (l>>1)] + PYR1_COLUMNS-1;
+	for(int i = 0; i < PYR1_COLUMNS; i++) {
+		unsigned char px = sums1[i] >> 2;
+		*(out1--) = px;
+		sums2[i>>1] += px;
+		sums1[i] = 0;
+	}
+
+	if((l&3) != 3)
+		return;
+
+	// four level 1 cells per level 2 cell are complete
+	unsigned char* out2 = level2[PYR2_ROWS-1 - (l>>2)] + PYR2_COLUMNS-1;
+	for(int i = 0; i < PYR2_COLUMNS; i++) {
+		*(out2--) = sums2[i] >> 2;
+		sums2[i] = 0;
+	}
+}
+
+/*
+ * Build both levels at once from a frame already stored, rows
+ * 1<<VGA_ROW_SHIFT bytes apart, for frames that were not
+ * captured through lineSums
+ */
+void Pyramid::build(const volatile unsigned char* frame) {
+	// same rounding as the line accumulators: each level is the
+	// four cells under it summed and shifted
+	for(int r = 0; r < PYR1_ROWS; r++) {
+		const volatile unsigned char* top = frame + ((r<<1) << VGA_ROW_SHIFT);
+		const volatile unsigned char* bottom = top + (1 << VGA_ROW_SHIFT);
+		for(int c = 0; c < PYR1_COLUMNS; c++) {
+			int c0 = c<<1;
+			level1[r][c] = (top[c0] + top[c0+1] + bottom[c0] + bottom[c0+1]) >> 2;
+		}
+	}
+
+	for(int r = 0; r < PYR2_ROWS; r++) {
+		for(int c = 0; c < PYR2_COLUMNS; c++) {
+			int r1 = r<<1;
+			int c1 = c<<1;
+			level2[r][c] = (level1[r1][c1] + level1[r1][c1+1] + level1[r1+1][c1] + level1[r1+1][c1+1]) >> 2;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+/*
+ * FILENAME:	Pyramid.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef PYRAMID_HPP
+#define PYRAMID_HPP
+
+#include "Camera.hpp"
+
+// Level 1 is the VGA frame downsampled 2x in each direction
+#define PYR1_ROWS (VGA_ROWS/2)
+#define PYR1_COLUMNS (VGA_COLUMNS/2)
+
+// Level 2 is the VGA frame downsampled 4x in each direction
+#define PYR2_ROWS (VGA_ROWS/4)
+#define PYR2_COLUMNS (VGA_COLUMNS/4)
+
+/*
+ * Pyramid class, builds 2x and 4x downsampled copies of the
+ * frame one line at a time while the frame is being captured.
+ * Levels are stored in the same orientation as the VGA memory.
+ */
+class Pyramid {
+private:
+	int line;
+
+protected:
+
+public:
+	unsigned char level1[PYR1_ROWS][PYR1_COLUMNS];
+	unsigned char level2[PYR2_ROWS][PYR2_COLUMNS];
+
+	/*
+	 * Constructor, clears the line accumulators
+	 */
+	Pyramid();
+
+	/*
+	 * Prepare for a new frame
+	 */
+	void begin();
+
+	/*
+	 * Accumulators the capture loop adds horizontal pixel pairs into,
+	 * index 0 is the first pair of the line as it leaves the sensor
+	 */
+	unsigned short* lineSums();
+
+	/*
+	 * Fold the accumulated line into the downsampled levels,
+	 * called while the sensor sends a line that is not sampled
+	 */
+	void finishLine();
+
+	/*
+	 * Build both levels at once from a frame already stored, rows
+	 * 1<<VGA_ROW_SHIFT bytes apart, for frames that were not
+	 * captured through lineSums
+	 */
+	void build(const volatile unsigned char* frame);
+};
+
+#endif /* PYRAMID_HPP */
@@ -0,0 +1,82 @@
+/*
+ * FILENAME:	Scheduler.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Scheduler.hpp"
+#include "Clock.hpp"
+
+#include <stdio.h>
+#include <stddef.h>
+
+static Task* table = NULL;
+static int size = 0;
+
+// Deadline held for this pass, and the task that holds it
+static bool holding;
+static unsigned int holdAt;
+static int holder;
+static int current;
+
+/*
+ * Run the tasks forever, highest priority first in the table
+ */
+void Scheduler::run(Task* tasks, int count) {
+	table = tasks;
+	size = count;
+
+	while(true) {
+		holding = false;
+
+		for(int i = 0; i < size; i++) {
+			Task* t = &table[i];
+			bool held = holding;
+			current = i;
+			if(!t->ready())
+				continue;
+
+			// only the time left before a deadline above is free
+			unsigned int now = Clock::now();
+			if(held && (int)(holdAt - now) < (int)(t->budget * CLOCK_TICKS_PER_US))
+				continue;
+
+			t->run();
+
+			unsigned int took = Clock::now() - now;
+			t->runs++;
+			if(took > t->worst)
+				t->worst = took;
+			if(took > t->budget * CLOCK_TICKS_PER_US)
+				t->overruns++;
+
+			// the deadline was this task's own and it has now been met
+			if(holding && holder == i)
+				holding = false;
+		}
+	}
+}
+
+/*
+ * Reserve the time from a timestamp on for the task asking, called
+ * from its ready function, lasts until the next pass
+ */
+void Scheduler::hold(unsigned int at) {
+	if(!holding || (int)(at - holdAt) < 0) {
+		holdAt = at;
+		holder = current;
+	}
+	holding = true;
+}
+
+/*
+ * Print how long each task has been taking against its budget
+ */
+void Scheduler::print() {
+	printf("%-10s %8s %8s %8s %8s\n", "TASK", "BUDGET", "WORST", "RUNS", "OVERRUNS");
+	for(int i = 0; i < size; i++) {
+		const Task* t = &table[i];
+		printf("%-10s %6uus %6uus %8u %8u\n", t->name, t->budget,
+				Clock::toMicros(t->worst), t->runs, t->overruns);
+	}
+}
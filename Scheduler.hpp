@@ -0,0 +1,37 @@
+/*
+ * FILENAME:	Scheduler.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "Task.h"
+
+/*
+ * Scheduler namespace, cooperative run loop over a table of tasks
+ * in priority order. Each pass runs every task that is ready and
+ * whose budget fits before any deadline held by the tasks above it,
+ * so background work only fills the time a deadline leaves free and
+ * a task that is always ready cannot starve the ones below it.
+ */
+namespace Scheduler {
+	/*
+	 * Run the tasks forever, highest priority first in the table
+	 */
+	void run(Task* tasks, int count);
+
+	/*
+	 * Reserve the time from a timestamp on for the task asking, called
+	 * from its ready function, lasts until the next pass
+	 */
+	void hold(unsigned int at);
+
+	/*
+	 * Print how long each task has been taking against its budget
+	 */
+	void print();
+}
+
+#endif /* SCHEDULER_HPP */
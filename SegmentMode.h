@@ -0,0 +1,20 @@
+/*
+ * FILENAME:	SegmentMode.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SEGMENTMODE_H
+#define SEGMENTMODE_H
+
+/*
+ * SegmentMode enum, determines which image the tracker
+ * thresholds before searching for runs of target pixels
+ */
+enum SegmentMode {
+	SEGMENT_BRIGHTNESS, SEGMENT_MOTION, SEGMENT_EDGE, SEGMENT_COLOR
+};
+
+typedef enum SegmentMode SegmentMode;
+
+#endif
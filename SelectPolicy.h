@@ -0,0 +1,20 @@
+/*
+ * FILENAME:	SelectPolicy.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SELECTPOLICY_H
+#define SELECTPOLICY_H
+
+/*
+ * SelectPolicy enum, determines which of several tracked
+ * targets drives the servos
+ */
+enum SelectPolicy {
+	SELECT_LARGEST, SELECT_OLDEST, SELECT_CENTER
+};
+
+typedef enum SelectPolicy SelectPolicy;
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * FILENAME:	ServoMotion.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "ServoMotion.hpp"
+#include "Math.hpp"
+
+// Fraction bits of positions and velocity
+#define MOTION_FRACTION 4
+
+// Limits in PWM counts per second and per second squared, the full
+// servo travel is about 1900 counts
+#define MOTION_VELOCITY 3000
+#define MOTION_ACCEL 60000
+
+// Limits per profile step, in fixed point
+#define VEL_STEP ((MOTION_VELOCITY * MOTION_PERIOD_MS << MOTION_FRACTION) / 1000)
+#define ACCEL_STEP ((MOTION_ACCEL * MOTION_PERIOD_MS * MOTION_PERIOD_MS << MOTION_FRACTION) / 1000000)
+
+/*
+ * Constructor, which half of the Servo module to control
+ */
+ServoMotion::ServoMotion(PWMIndex index) : Servo(index), target(0), position(0),
+		lower(0), upper(PWM_MAX_COUNT << MOTION_FRACTION), velocity(0), placed(false), steps(0) { }
+
+/*
+ * Set the position (0.0 to 1.0 duty cycle) to move toward, the
+ * first target ever set is taken immediately
+ */
+void ServoMotion::setTarget(float dc) {
+	int t = (int)(Math::clamp<float>(dc, 0.0f, 1.0f) * PWM_MAX_COUNT) << MOTION_FRACTION;
+
+	// where the servo starts is unknown, so there is nothing to profile from
+	if(!placed) {
+		position = t;
+		for(int i = 0; i < MOTION_HISTORY; i++)
+			history[i] = t >> MOTION_FRACTION;
+		placed = true;
+	}
+	target = t;
+}
+
+/*
+ * Set the travel limits (0.0 to 1.0 duty cycle), the output stops
+ * at them even when a target changes too late to brake for
+ */
+void ServoMotion::setLimits(float min, float max) {
+	lower = (int)(Math::clamp<float>(min, 0.0f, 1.0f) * PWM_MAX_COUNT) << MOTION_FRACTION;
+	upper = (int)(Math::clamp<float>(max, 0.0f, 1.0f) * PWM_MAX_COUNT) << MOTION_FRACTION;
+}
+
+/*
+ * Get the position being moved toward
+ */
+float ServoMotion::getTarget() {
+	return (target >> MOTION_FRACTION) * (1.0f / PWM_MAX_COUNT);
+}
+
+/*
+ * Check whether the servo has reached its target
+ */
+bool ServoMotion::isSettled() {
+	return position == target;
+}
+
+/*
+ * Get the number of the last profile step, steps are
+ * MOTION_PERIOD_MS apart
+ */
+unsigned int ServoMotion::getStep() {
+	return steps;
+}
+
+/*
+ * Get the count output at a step, steps older than the history
+ * give the oldest count kept
+ */
+int ServoMotion::countAt(unsigned int step) {
+	unsigned int now = steps;
+	if(now - step >= MOTION_HISTORY)
+		step = now - (MOTION_HISTORY-1);
+	return history[step & (MOTION_HISTORY-1)];
+}
+
+/*
+ * Get how far the output travelled (largest minus smallest
+ * count) over a range of steps
+ */
+int ServoMotion::travel(unsigned int from, unsigned int to) {
+	if(to - from >= MOTION_HISTORY)
+		from = to - (MOTION_HISTORY-1);
+
+	int lo = countAt(to);
+	int hi = lo;
+	for(unsigned int s = from; s != to; s++) {
+		int count = countAt(s);
+		lo = Math::min(lo, count);
+		hi = Math::max(hi, count);
+	}
+	return hi - lo;
+}
+
+/*
+ * Advance the profile by one period, called from the interrupt,
+ * returns the count to output
+ */
+int ServoMotion::step() {
+	if(!placed)
+		return getCount();
+
+	int count = profile();
+	history[++steps & (MOTION_HISTORY-1)] = count;
+	return count;
+}
+
+/*
+ * Move the position one period along the profile, returns
+ * the count it rounds to
+ */
+int ServoMotion::profile() {
+	int dist = target - position;
+	int v = velocity;
+
+	// close enough to stop within one step
+	if(Math::abs(dist) <= ACCEL_STEP && Math::abs(v) <= ACCEL_STEP) {
+		velocity = 0;
+		position = target;
+		return target >> MOTION_FRACTION;
+	}
+
+	// brake once the stopping distance v*v/(2a) reaches what is left
+	// after this step's move, compared without dividing, otherwise
+	// speed up toward the target
+	if(v != 0 && (v > 0) == (dist > 0) && v*v >= 2*ACCEL_STEP*Math::abs(dist - v))
+		v += v > 0 ? -ACCEL_STEP : ACCEL_STEP;
+	else
+		v = Math::clamp(v + (dist > 0 ? ACCEL_STEP : -ACCEL_STEP), -VEL_STEP, VEL_STEP);
+
+	// a step that would reach or pass the target stops on it, so the
+	// output never goes past a target clamped to the travel limits
+	if((v > 0) == (dist > 0) && Math::abs(v) >= Math::abs(dist)) {
+		velocity = 0;
+		position = target;
+		return target >> MOTION_FRACTION;
+	}
+
+	velocity = v;
+	position += v;
+
+	// turning back near the end of the travel would carry it past
+	if(position < lower || position > upper) {
+		position = Math::clamp<int>(position, lower, upper);
+		velocity = 0;
+	}
+	return (position + (1 << (MOTION_FRACTION-1))) >> MOTION_FRACTION;
+}
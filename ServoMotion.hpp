@@ -0,0 +1,99 @@
+/*
+ * FILENAME:	ServoMotion.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SERVOMOTION_HPP
+#define SERVOMOTION_HPP
+
+#include "Servo.hpp"
+
+// Interval between profile steps, milliseconds
+#define MOTION_PERIOD_MS 5
+
+// Profile steps of output kept to look back on (power of two), 1.28 s
+#define MOTION_HISTORY 256
+
+/*
+ * ServoMotion class, extension of Servo class, moves toward a target
+ * position under velocity and acceleration limits instead of stepping
+ * to it. The profile is advanced from the motion engine interrupt,
+ * which writes the resulting counts through its output stage.
+ */
+class ServoMotion : public Servo {
+private:
+	// positions and velocity in PWM counts with MOTION_FRACTION fraction bits
+	volatile int target;
+	volatile int position;
+	volatile int lower;
+	volatile int upper;
+	int velocity;
+	bool placed;
+
+	// counts output by the last MOTION_HISTORY steps, by step number
+	volatile unsigned int steps;
+	unsigned short history[MOTION_HISTORY];
+
+	/*
+	 * Move the position one period along the profile, returns
+	 * the count it rounds to
+	 */
+	int profile();
+
+protected:
+
+public:
+	/*
+	 * Constructor, which half of the Servo module to control
+	 */
+	ServoMotion(PWMIndex index);
+
+	/*
+	 * Set the position (0.0 to 1.0 duty cycle) to move toward, the
+	 * first target ever set is taken immediately
+	 */
+	void setTarget(float dc);
+
+	/*
+	 * Set the travel limits (0.0 to 1.0 duty cycle), the output stops
+	 * at them even when a target changes too late to brake for
+	 */
+	void setLimits(float min, float max);
+
+	/*
+	 * Get the position being moved toward
+	 */
+	float getTarget();
+
+	/*
+	 * Check whether the servo has reached its target
+	 */
+	bool isSettled();
+
+	/*
+	 * Get the number of the last profile step, steps are
+	 * MOTION_PERIOD_MS apart
+	 */
+	unsigned int getStep();
+
+	/*
+	 * Get the count output at a step, steps older than the history
+	 * give the oldest count kept
+	 */
+	int countAt(unsigned int step);
+
+	/*
+	 * Get how far the output travelled (largest minus smallest
+	 * count) over a range of steps
+	 */
+	int travel(unsigned int from, unsigned int to);
+
+	/*
+	 * Advance the profile by one period, called from the interrupt,
+	 * returns the count to output
+	 */
+	int step();
+};
+
+#endif /* SERVOMOTION_HPP */
@@ -0,0 +1,31 @@
+/*
+ * FILENAME:	Task.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+/*
+ * Task struct, one entry of the scheduler's table. A task is a
+ * state machine: each run does one step of work and returns, and
+ * ready says whether there is a step to do. The budget is how long
+ * a run is expected to take, a task is not started when its budget
+ * would reach past a deadline held by a task above it.
+ */
+struct Task {
+	const char* name;
+	bool (*ready)();
+	void (*run)();
+	unsigned int budget;		// microseconds
+
+	// kept by the scheduler
+	unsigned int runs;
+	unsigned int overruns;
+	unsigned int worst;			// CPU clock ticks
+};
+
+typedef struct Task Task;
+
+#endif
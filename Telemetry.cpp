@@ -0,0 +1,110 @@
+/*
+ * FILENAME:	Telemetry.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Telemetry.hpp"
+#include "Clock.hpp"
+
+// Record layout must not depend on the compiler
+typedef char TelemetryRecordSize[(sizeof(TelemetryRecord) == 28) ? 1 : -1];
+
+/*
+ * Clamp a tick interval to the microseconds a record can hold
+ */
+static unsigned short micros(unsigned int from, unsigned int to) {
+	unsigned int us = Clock::toMicros(to - from);
+	return us > 0xFFFF ? 0xFFFF : us;
+}
+
+/*
+ * Convert a frame coordinate to a record byte
+ */
+static unsigned char coord(float v) {
+	return (v < 0.0f || v >= 255.0f) ? TELEM_NONE : (unsigned char)v;
+}
+
+/*
+ * Constructor, records are sent over a shared link
+ */
+Telemetry::Telemetry(Link* link) : head(0), tail(0), sent(0), seq(0), dropped(0), enabled(false), link(link) { }
+
+/*
+ * Start or stop producing records
+ */
+void Telemetry::enable(bool on) {
+	enabled = on;
+}
+
+/*
+ * Queue a record of a frame, dropped if the ring is full,
+ * returns false if the record was not queued
+ */
+bool Telemetry::record(const FrameReport* report) {
+	if(!enabled)
+		return false;
+
+	if(head - tail == TELEM_RING) {
+		dropped++;
+		seq++;
+		return false;
+	}
+
+	TelemetryRecord* rec = &ring[head & (TELEM_RING-1)];
+	rec->sync = TELEM_SYNC;
+	rec->seq = seq++;
+	rec->timestamp = report->start;
+	rec->threshold = report->threshold;
+	rec->flags = (report->found ? TELEM_FOUND : 0) | (report->hasBox ? TELEM_BOX : 0)
+			| (report->segment << TELEM_SEGMENT_SHIFT) | (report->tracker << TELEM_TRACKER_SHIFT);
+	rec->row = report->found ? coord(report->row) : TELEM_NONE;
+	rec->col = report->found ? coord(report->col) : TELEM_NONE;
+	rec->ulr = report->hasBox ? report->ulr : TELEM_NONE;
+	rec->ulc = report->hasBox ? report->ulc : TELEM_NONE;
+	rec->lrr = report->hasBox ? report->lrr : TELEM_NONE;
+	rec->lrc = report->hasBox ? report->lrc : TELEM_NONE;
+	rec->pan = (short)(report->pan * 100.0f);
+	rec->tilt = (short)(report->tilt * 100.0f);
+	rec->capture = micros(report->start, report->captured);
+	rec->analysis = micros(report->captured, report->analyzed);
+	rec->control = micros(report->analyzed, report->controlled);
+
+	unsigned short sum = 0;
+	unsigned char* bytes = (unsigned char*)rec;
+	for(unsigned int i = 0; i < sizeof(TelemetryRecord) - sizeof(rec->checksum); i++)
+		sum += bytes[i];
+	rec->checksum = sum;
+
+	// publish only once the record is complete
+	head++;
+	return true;
+}
+
+/*
+ * Send as much of the queued records as the link takes right now
+ */
+void Telemetry::drain() {
+	while(tail != head) {
+		const char* bytes = (const char*)&ring[tail & (TELEM_RING-1)];
+		int n = link->send(LINK_TELEMETRY, bytes + sent, sizeof(TelemetryRecord) - sent);
+
+		// link is full or busy, try again on the next pass of the main loop
+		if(n == 0)
+			return;
+
+		sent += n;
+		if(sent == sizeof(TelemetryRecord)) {
+			link->release(LINK_TELEMETRY);
+			sent = 0;
+			tail++;
+		}
+	}
+}
+
+/*
+ * Get the number of records dropped because the ring was full
+ */
+unsigned int Telemetry::getDropped() {
+	return dropped;
+}
@@ -0,0 +1,63 @@
+/*
+ * FILENAME:	Telemetry.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include "TelemetryRecord.h"
+#include "FrameReport.h"
+#include "Link.hpp"
+
+// Records buffered between drains, must be a power of two
+#define TELEM_RING 16
+
+/*
+ * Telemetry class, queues a binary record per frame and sends it
+ * over the JTAG UART only as fast as the link accepts it. The tracker
+ * produces and the main loop consumes; neither ever waits on the other.
+ */
+class Telemetry {
+private:
+	TelemetryRecord ring[TELEM_RING];
+	volatile unsigned int head;
+	volatile unsigned int tail;
+	unsigned int sent;
+	unsigned short seq;
+	unsigned int dropped;
+	bool enabled;
+	Link* link;
+
+protected:
+
+public:
+	/*
+	 * Constructor, records are sent over a shared link
+	 */
+	Telemetry(Link* link);
+
+	/*
+	 * Start or stop producing records
+	 */
+	void enable(bool on);
+
+	/*
+	 * Queue a record of a frame, dropped if the ring is full,
+	 * returns false if the record was not queued
+	 */
+	bool record(const FrameReport* report);
+
+	/*
+	 * Send as much of the queued records as the link takes right now
+	 */
+	void drain();
+
+	/*
+	 * Get the number of records dropped because the ring was full
+	 */
+	unsigned int getDropped();
+};
+
+#endif /* TELEMETRY_HPP */
@@ -0,0 +1,49 @@
+/*
+ * FILENAME:	TelemetryRecord.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TELEMETRYRECORD_H
+#define TELEMETRYRECORD_H
+
+// First two bytes of every record, as sent (little endian)
+#define TELEM_SYNC 0x5AA5
+
+// Record flag bits
+#define TELEM_FOUND (1<<0)
+#define TELEM_BOX (1<<1)
+#define TELEM_SEGMENT_SHIFT 4
+#define TELEM_TRACKER_SHIFT 6
+
+// Centroid and box coordinate meaning no value
+#define TELEM_NONE 0xFF
+
+/*
+ * TelemetryRecord struct, the fixed 28 byte frame sent for every
+ * tracked camera frame. All fields are naturally aligned so the
+ * layout is the same on the board and on a little endian host.
+ */
+struct TelemetryRecord {
+	unsigned short sync;
+	unsigned short seq;
+	unsigned int timestamp;		// capture start, CPU clock ticks
+	unsigned char threshold;
+	unsigned char flags;
+	unsigned char row;			// target centroid
+	unsigned char col;
+	unsigned char ulr;			// target box
+	unsigned char ulc;
+	unsigned char lrr;
+	unsigned char lrc;
+	short pan;					// commanded position, 1/100 degree
+	short tilt;
+	unsigned short capture;		// stage times, microseconds
+	unsigned short analysis;
+	unsigned short control;
+	unsigned short checksum;	// sum of all previous bytes
+};
+
+typedef struct TelemetryRecord TelemetryRecord;
+
+#endif
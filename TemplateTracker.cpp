@@ -0,0 +1,207 @@
+/*
+ * FILENAME:	TemplateTracker.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "TemplateTracker.hpp"
+#include "Camera.hpp"
+#include "Math.hpp"
+#include "Arena.hpp"
+
+#include <stddef.h>
+
+// Average difference per pixel above which the target is lost
+#define TMPL_LOST_PX 24
+// Average difference per pixel below which the patch is updated
+#define TMPL_BLEND_PX 12
+// Patch follows the matched pixels at a rate of 1/(1<<TMPL_LEARN_SHIFT)
+#define TMPL_LEARN_SHIFT 4
+
+#define TMPL_PIXELS (TMPL_ROWS*TMPL_COLUMNS)
+
+// Byte lane masks
+#define LANE_HI 0x80808080u
+#define LANE_LO 0x7F7F7F7Fu
+
+/*
+ * Absolute difference of four packed pixels, returned as two
+ * 16 bit lanes which each hold the sum of two differences
+ */
+static inline unsigned int sad4(unsigned int a, unsigned int b) {
+	// per byte a-b, and the borrow out of each byte (set where a < b)
+	unsigned int d = ((a | LANE_HI) - (b & LANE_LO)) ^ ((a ^ ~b) & LANE_HI);
+	unsigned int borrow = ((~a & b) | (~(a ^ b) & d)) & LANE_HI;
+	unsigned int lt = (borrow >> 7) * 0xFF;
+
+	// larger minus smaller in every byte never borrows
+	unsigned int ad = ((a & ~lt) | (b & lt)) - ((a & lt) | (b & ~lt));
+	return (ad & 0x00FF00FF) + ((ad >> 8) & 0x00FF00FF);
+}
+
+/*
+ * Read four pixels from a window row starting at any byte offset
+ */
+static inline unsigned int unaligned(unsigned int* src, int shift) {
+	if(shift == 0)
+		return src[0];
+	return (src[0] >> shift) | (src[1] << (32 - shift));
+}
+
+/*
+ * Constructor, tracker starts without a lock
+ */
+TemplateTracker::TemplateTracker() {
+	release();
+}
+
+/*
+ * Capture the reference patch centred on a frame position
+ */
+void TemplateTracker::acquire(volatile unsigned char* frame, int row, int col) {
+	this->row = Math::clamp(row - TMPL_ROWS/2, 0, VGA_ROWS - TMPL_ROWS);
+	this->col = Math::clamp(col - TMPL_COLUMNS/2, 0, VGA_COLUMNS - TMPL_COLUMNS);
+
+	for(int r = 0; r < TMPL_ROWS; r++) {
+		volatile unsigned char* px = frame + ((this->row + r)<<VGA_ROW_SHIFT) + this->col;
+		for(int c = 0; c < TMPL_COLUMNS; c++)
+			average[r][c] = px[c] << 8;
+		for(int w = 0; w < TMPL_WORDS; w++)
+			patch[r][w] = px[4*w] | (px[4*w+1] << 8) | (px[4*w+2] << 16) | (px[4*w+3] << 24);
+	}
+
+	velRow = 0;
+	velCol = 0;
+	locked = true;
+}
+
+/*
+ * Find the patch near its predicted position, returns false
+ * and drops the lock if nothing in the window matches
+ */
+bool TemplateTracker::match(volatile unsigned char* frame, float* row, float* col) {
+	if(!locked)
+		return false;
+
+	// predicted position and the window searched around it
+	int pr = Math::clamp(this->row + velRow, 0, VGA_ROWS - TMPL_ROWS);
+	int pc = Math::clamp(this->col + velCol, 0, VGA_COLUMNS - TMPL_COLUMNS);
+	int r0 = Math::max(pr - TMPL_RADIUS, 0);
+	int r1 = Math::min(pr + TMPL_RADIUS, VGA_ROWS - TMPL_ROWS);
+	int c0 = Math::max(pc - TMPL_RADIUS, 0);
+	int c1 = Math::min(pc + TMPL_RADIUS, VGA_COLUMNS - TMPL_COLUMNS);
+	int base = c0 & ~3;
+
+	// the window only lives for this frame
+	unsigned int mark = Arena::mark();
+	window = (unsigned int (*)[TMPL_WIN_WORDS])Arena::take(TMPL_WIN_ROWS * TMPL_WIN_WORDS * 4);
+	if(window == NULL) {
+		release();
+		return false;
+	}
+
+	// copy the window out of VGA memory once with aligned word reads
+	for(int r = 0; r < r1 - r0 + TMPL_ROWS; r++) {
+		volatile unsigned int* src = (volatile unsigned int*)(frame + ((r0 + r)<<VGA_ROW_SHIFT) + base);
+		for(int w = 0; w < TMPL_WIN_WORDS; w++)
+			window[r][w] = src[w];
+	}
+
+	// start at the prediction so early termination cuts off most candidates
+	int bestRow = pr;
+	int bestCol = pc;
+	unsigned int best = sad(pr - r0, pc - base, 0xFFFFFFFF);
+
+	for(int r = r0; r <= r1; r++) {
+		for(int c = c0; c <= c1; c++) {
+			unsigned int s = sad(r - r0, c - base, best);
+			if(s < best) {
+				best = s;
+				bestRow = r;
+				bestCol = c;
+			}
+		}
+	}
+
+	if(best > TMPL_LOST_PX*TMPL_PIXELS) {
+		Arena::release(mark);
+		release();
+		return false;
+	}
+
+	velRow = bestRow - this->row;
+	velCol = bestCol - this->col;
+	this->row = bestRow;
+	this->col = bestCol;
+
+	// follow slow changes in appearance, but never learn a poor match
+	if(best < TMPL_BLEND_PX*TMPL_PIXELS)
+		blend(bestRow - r0, bestCol - base);
+	Arena::release(mark);
+
+	*row = (float)this->row + (TMPL_ROWS-1) / 2.0f;
+	*col = (float)this->col + (TMPL_COLUMNS-1) / 2.0f;
+	return true;
+}
+
+/*
+ * Sum of absolute differences between the patch and the window
+ * at a row and byte offset, stops once the sum reaches limit
+ */
+unsigned int TemplateTracker::sad(int winRow, int winByte, unsigned int limit) {
+	int shift = (winByte & 3) << 3;
+	unsigned int lanes = 0;
+	unsigned int sum = 0;
+
+	for(int r = 0; r < TMPL_ROWS; r++) {
+		unsigned int* src = window[winRow + r] + (winByte >> 2);
+		unsigned int* ref = patch[r];
+
+		for(int w = 0; w < TMPL_WORDS; w++)
+			lanes += sad4(ref[w], unaligned(src + w, shift));
+
+		sum = (lanes & 0xFFFF) + (lanes >> 16);
+		if(sum >= limit)
+			break;
+	}
+
+	return sum;
+}
+
+/*
+ * Blend the matched pixels into the reference patch
+ */
+void TemplateTracker::blend(int winRow, int winByte) {
+	int shift = (winByte & 3) << 3;
+
+	for(int r = 0; r < TMPL_ROWS; r++) {
+		unsigned int* src = window[winRow + r] + (winByte >> 2);
+		unsigned short* avg = average[r];
+
+		for(int w = 0; w < TMPL_WORDS; w++) {
+			unsigned int in = unaligned(src + w, shift);
+			unsigned int out = 0;
+
+			for(int b = 0; b < 4; b++) {
+				int px = (in >> (8*b)) & 0xFF;
+				avg[4*w+b] += ((px << 8) - avg[4*w+b]) >> TMPL_LEARN_SHIFT;
+				out |= (avg[4*w+b] >> 8) << (8*b);
+			}
+			patch[r][w] = out;
+		}
+	}
+}
+
+/*
+ * Drop the lock
+ */
+void TemplateTracker::release() {
+	locked = false;
+}
+
+/*
+ * Check if a reference patch is being followed
+ */
+bool TemplateTracker::isLocked() {
+	return locked;
+}
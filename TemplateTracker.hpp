@@ -0,0 +1,78 @@
+/*
+ * FILENAME:	TemplateTracker.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TEMPLATETRACKER_HPP
+#define TEMPLATETRACKER_HPP
+
+// Reference patch dimensions, columns must be a multiple of 4
+#define TMPL_ROWS 8
+#define TMPL_COLUMNS 16
+#define TMPL_WORDS (TMPL_COLUMNS/4)
+
+// Pixels searched in every direction around the predicted position
+#define TMPL_RADIUS 6
+
+// Search window copied out of the frame, one extra word for unaligned reads
+#define TMPL_WIN_ROWS (TMPL_ROWS + 2*TMPL_RADIUS)
+#define TMPL_WIN_WORDS ((TMPL_COLUMNS + 2*TMPL_RADIUS + 3)/4 + 1)
+
+/*
+ * TemplateTracker class, follows a reference patch from frame
+ * to frame by minimizing the sum of absolute differences
+ */
+class TemplateTracker {
+private:
+	unsigned int patch[TMPL_ROWS][TMPL_WORDS];
+	unsigned short average[TMPL_ROWS][TMPL_COLUMNS];
+	unsigned int (*window)[TMPL_WIN_WORDS];
+	bool locked;
+	int row;
+	int col;
+	int velRow;
+	int velCol;
+
+	/*
+	 * Sum of absolute differences between the patch and the window
+	 * at a row and byte offset, stops once the sum reaches limit
+	 */
+	unsigned int sad(int winRow, int winByte, unsigned int limit);
+
+	/*
+	 * Blend the matched pixels into the reference patch
+	 */
+	void blend(int winRow, int winByte);
+
+protected:
+
+public:
+	/*
+	 * Constructor, tracker starts without a lock
+	 */
+	TemplateTracker();
+
+	/*
+	 * Capture the reference patch centred on a frame position
+	 */
+	void acquire(volatile unsigned char* frame, int row, int col);
+
+	/*
+	 * Find the patch near its predicted position, returns false
+	 * and drops the lock if nothing in the window matches
+	 */
+	bool match(volatile unsigned char* frame, float* row, float* col);
+
+	/*
+	 * Drop the lock
+	 */
+	void release();
+
+	/*
+	 * Check if a reference patch is being followed
+	 */
+	bool isLocked();
+};
+
+#endif /* TEMPLATETRACKER_HPP */
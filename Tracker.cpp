@@ -0,0 +1,476 @@
+/*
+ * FILENAME:	Tracker.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Tracker.hpp"
+#include "Math.hpp"
+#include "Clock.hpp"
+#include "Arena.hpp"
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Middle of the region of interest
+#define ROW_MID ((params->rowEnd+params->rowStart)/2)
+#define COL_MID ((params->colEnd+params->colStart)/2)
+
+// Coarse cells refined when reacquiring a lost target
+#define REACQ_CANDIDATES 3
+// Full resolution pixels searched around a candidate cell
+#define REACQ_MARGIN 2
+// Smallest coarse min/max spread that can contain a target
+#define REACQ_CONTRAST 32
+
+/*
+ * Constructor, tracks with the given parameters and records
+ * annotations in the given overlay
+ */
+Tracker::Tracker(const TrackerParams* params, Overlay* overlay) {
+	this->params = params;
+	this->overlay = overlay;
+	mode = SEGMENT_BRIGHTNESS;
+	tracker = TRACKER_RUNS;
+	lockPending = false;
+	lockRow = 0;
+	lockCol = 0;
+	threshold = 128;
+	frame = NULL;
+	pyramid = NULL;
+	uPlane = NULL;
+	vPlane = NULL;
+	report = NULL;
+}
+
+/*
+ * Get a pointer to a pixel of the frame, clamped to the frame
+ */
+volatile unsigned char* Tracker::pixel(int row, int column) {
+	row = Math::clamp(row, 0, VGA_ROWS-1);
+	column = Math::clamp(column, 0, VGA_COLUMNS-1);
+	return frame + (row<<VGA_ROW_SHIFT) + column;
+}
+
+/*
+ * Take a new frame to analyze, with its downsampled levels,
+ * chroma planes (only read in colour mode) and the threshold
+ * halfway through its range, results go to the report
+ */
+void Tracker::begin(volatile unsigned char* frame, Pyramid* pyramid, const unsigned char* u,
+		const unsigned char* v, unsigned char threshold, FrameReport* report) {
+	this->frame = frame;
+	this->pyramid = pyramid;
+	this->uPlane = u;
+	this->vPlane = v;
+	this->threshold = threshold;
+	this->report = report;
+	report->found = false;
+	report->hasBox = false;
+}
+
+/*
+ * Segment the region of interest and choose the threshold
+ * that separates the target from the rest of the frame
+ */
+void Tracker::updateThreshold() {
+	const int rowStart = params->rowStart;
+	const int rowEnd = params->rowEnd;
+	const int colStart = params->colStart;
+	const int colEnd = params->colEnd;
+
+	if(mode == SEGMENT_MOTION) {
+		threshold = background.apply(pixel(0,0), rowStart, rowEnd, colStart, colEnd);
+		return;
+	}
+
+	if(mode == SEGMENT_COLOR) {
+		threshold = colors.apply(pixel(0,0), uPlane, vPlane, rowStart, rowEnd, colStart, colEnd);
+		return;
+	}
+
+	if(mode == SEGMENT_EDGE) {
+		threshold = edges.apply(pixel(0,0), rowStart, rowEnd, colStart, colEnd);
+		return;
+	}
+
+	unsigned char max = 0;
+	unsigned char min = 255;
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		for(int c = colStart; c < colEnd; c++) {
+			unsigned char px = *(pixel(r,c));
+			max = px > max ? px : max;
+			min = px < min ? px : min;
+		}
+	}
+
+	threshold = (max>>1) + (min>>1);
+}
+
+/*
+ * Select whether the tracker follows bright, moving, edged or coloured objects
+ */
+void Tracker::setSegmentMode(SegmentMode mode) {
+	// a stale background would show everything as motion
+	if(mode == SEGMENT_MOTION && this->mode != SEGMENT_MOTION)
+		background.reset();
+
+	this->mode = mode;
+}
+
+SegmentMode Tracker::getSegmentMode() {
+	return mode;
+}
+
+/*
+ * Set the U and V ranges followed in colour mode
+ */
+void Tracker::setColorBox(bool v, unsigned char min, unsigned char max) {
+	if(v)
+		colors.setVBox(min, max);
+	else
+		colors.setUBox(min, max);
+}
+
+/*
+ * Find the longest runs in the frame and aim at them
+ */
+void Tracker::findRuns() {
+	int ulr, ulc, lrr, lrc;
+
+	// target left the region of interest, search the whole frame
+	if(!findTarget(&ulr, &ulc, &lrr, &lrc)) {
+		float row, col;
+		if(mode == SEGMENT_BRIGHTNESS && reacquire(&row, &col))
+			aimAt(row, col);
+		return;
+	}
+
+	report->hasBox = true;
+	report->ulr = ulr;
+	report->ulc = ulc;
+	report->lrr = lrr;
+	report->lrc = lrc;
+
+	overlay->box(ulr, ulc, lrr, lrc, 196);
+
+	aimAt((((float)ulr) + ((float)lrr)) / 2.0f, (((float)ulc) + ((float)lrc)) / 2.0f);
+}
+
+/*
+ * Follow the reference patch captured when the target was locked
+ */
+void Tracker::trackTemplate() {
+	float row, col;
+
+	if(templ.isLocked()) {
+		if(templ.match(frame, &row, &col))
+			aimAt(row, col);
+		return;
+	}
+
+	// patch is taken from this raw frame where the last segmented frame found the target
+	if(lockPending) {
+		templ.acquire(frame, lockRow, lockCol);
+		lockPending = false;
+		return;
+	}
+
+	int ulr, ulc, lrr, lrc;
+	updateThreshold();
+	if(findTarget(&ulr, &ulc, &lrr, &lrc)) {
+		lockRow = (ulr + lrr) / 2;
+		lockCol = (ulc + lrc) / 2;
+		lockPending = true;
+	}
+}
+
+/*
+ * Locate the target in the frame with the selected tracker,
+ * frames taken while the mount moved are only reported
+ */
+void Tracker::track(bool steady) {
+	// frames taken during travel are not acted on
+	if(steady) {
+		if(tracker == TRACKER_TEMPLATE) {
+			trackTemplate();
+		} else if(tracker == TRACKER_MULTI) {
+			trackTargets();
+		} else {
+			updateThreshold();
+			findRuns();
+		}
+	}
+
+	if(!report->found)
+		report->analyzed = Clock::now();
+	report->threshold = threshold;
+	report->segment = mode;
+	report->tracker = tracker;
+}
+
+/*
+ * Select how the target is located in each frame
+ */
+void Tracker::setTrackerMode(TrackerMode tracker) {
+	templ.release();
+	targets.reset();
+	lockPending = false;
+	this->tracker = tracker;
+}
+
+/*
+ * Follow every blob in view and aim at the track the policy selects
+ */
+void Tracker::trackTargets() {
+	updateThreshold();
+
+	// the blob list only lives until the tracks are updated
+	unsigned int mark = Arena::mark();
+	Blob* blobs = (Blob*)Arena::take(MAX_BLOBS * sizeof(Blob));
+	int n = 0;
+	if(blobs != NULL)
+		n = blobFinder.find(pixel(0,0), threshold, params->rowStart, params->rowEnd, params->colStart, params->colEnd, blobs, MAX_BLOBS);
+	targets.update(blobs, n);
+	for(int i = 0; i < n; i++)
+		overlay->box(blobs[i].ulr, blobs[i].ulc, blobs[i].lrr, blobs[i].lrc, 196);
+	Arena::release(mark);
+
+	// a coasting track is only a prediction, hold still until it is seen again
+	Track* t = targets.select((float)ROW_MID, (float)COL_MID);
+	if(t != NULL && t->misses == 0)
+		aimAt(t->row, t->col);
+}
+
+/*
+ * Find the centroid of the largest blob in the frame,
+ * returns false if there is none
+ */
+bool Tracker::locate(float* row, float* col) {
+	updateThreshold();
+
+	unsigned int mark = Arena::mark();
+	Blob* blob = (Blob*)Arena::take(sizeof(Blob));
+	bool found = blob != NULL &&
+			blobFinder.find(pixel(0,0), threshold, params->rowStart, params->rowEnd, params->colStart, params->colEnd, blob, 1) > 0;
+	if(found) {
+		*row = blob->row;
+		*col = blob->col;
+	}
+	Arena::release(mark);
+	return found;
+}
+
+/*
+ * Select which target drives the servos when several are in view
+ */
+void Tracker::setSelectPolicy(SelectPolicy policy) {
+	targets.setPolicy(policy);
+}
+
+/*
+ * Print the state of every target being followed
+ */
+void Tracker::printTargets() {
+	Track* sel = targets.select((float)ROW_MID, (float)COL_MID);
+	for(int i = 0; i < MAX_TRACKS; i++) {
+		Track* t = targets.get(i);
+		if(!t->active)
+			continue;
+		printf("%c%d: (%d,%d) vel (%d,%d) size %d age %d misses %d\n", t == sel ? '*' : ' ', t->id,
+				(int)t->row, (int)t->col, (int)t->velRow, (int)t->velCol, t->size, t->age, t->misses);
+	}
+}
+
+/*
+ * Find the longest horizontal and vertical runs of pixels over
+ * the threshold, returns false if there is no target in the
+ * region of interest
+ */
+bool Tracker::findTarget(int* ulr, int* ulc, int* lrr, int* lrc) {
+	const int rowStart = params->rowStart;
+	const int rowEnd = params->rowEnd;
+	const int colStart = params->colStart;
+	const int colEnd = params->colEnd;
+	const int pxrowCols = params->pxrowCols;
+	const int pxrowRows = params->pxrowRows;
+	int pxInARow = 0;
+	bool found = true;
+
+	int maxInARow = 0;
+
+	*ulr = rowStart;
+	*ulc = colStart;
+
+	*lrr = rowEnd;
+	*lrc = colEnd;
+
+	for(int r = rowStart; r < rowEnd; r++) {
+		for(int c = colStart; c < colEnd; c++) {
+			unsigned char px = *(pixel(r,c));
+			if(px > threshold) {
+				pxInARow++;
+			} else {
+				if(pxInARow > pxrowCols && pxInARow > maxInARow) {
+					maxInARow = pxInARow;
+					*ulc = c-pxInARow;
+					*lrc = c-1;
+				}
+				pxInARow = 0;
+			}
+		}
+	}
+
+	found = found && (maxInARow > 0);
+	pxInARow=0;
+	maxInARow = 0;
+	for(int c = colStart; c < colEnd; c++) {
+		for(int r = rowStart; r < rowEnd; r++) {
+			unsigned char px = *(pixel(r,c));
+			if(px > threshold) {
+				pxInARow++;
+			} else {
+				if(pxInARow > pxrowRows && pxInARow > maxInARow) {
+					maxInARow = pxInARow;
+					*ulr = r-pxInARow;
+					*lrr = r-1;
+				}
+				pxInARow = 0;
+			}
+		}
+	}
+
+	found = found && (maxInARow > 0);
+
+	return found;
+}
+
+/*
+ * Take a point in the frame as the target
+ */
+void Tracker::aimAt(float row, float col) {
+	report->analyzed = Clock::now();
+	report->found = true;
+	report->row = row;
+	report->col = col;
+	overlay->cross((int)(row + 0.5f), (int)(col + 0.5f), 255);
+}
+
+/*
+ * Search the whole frame coarse-to-fine for the brightest object,
+ * returns false if the frame has no object worth following
+ */
+bool Tracker::reacquire(float* row, float* col) {
+	Pyramid* pyr = pyramid;
+	int cand[REACQ_CANDIDATES];
+	unsigned char candVal[REACQ_CANDIDATES];
+	int n = 0;
+
+	// threshold the 4x downsampled level
+	unsigned char max = 0;
+	unsigned char min = 255;
+	for(int r = 0; r < PYR2_ROWS; r++) {
+		for(int c = 0; c < PYR2_COLUMNS; c++) {
+			unsigned char px = pyr->level2[r][c];
+			max = px > max ? px : max;
+			min = px < min ? px : min;
+		}
+	}
+
+	// flat frame, nothing stands out
+	if(max - min < REACQ_CONTRAST)
+		return false;
+
+	unsigned char th = (max>>1) + (min>>1);
+
+	// keep the brightest few coarse cells as candidates
+	for(int r = 0; r < PYR2_ROWS; r++) {
+		for(int c = 0; c < PYR2_COLUMNS; c++) {
+			unsigned char px = pyr->level2[r][c];
+			if(px <= th)
+				continue;
+
+			int i;
+			if(n < REACQ_CANDIDATES)
+				i = n++;
+			else if(px > candVal[n-1])
+				i = n-1;
+			else
+				continue;
+
+			// insertion sort, brightest first
+			while(i > 0 && candVal[i-1] < px) {
+				cand[i] = cand[i-1];
+				candVal[i] = candVal[i-1];
+				i--;
+			}
+			cand[i] = (r<<8) | c;
+			candVal[i] = px;
+		}
+	}
+
+	// refine each candidate at full resolution, the one with
+	// the most pixels over the threshold wins
+	int bestCount = 0;
+	for(int i = 0; i < n; i++) {
+		int r2 = cand[i]>>8;
+		int c2 = cand[i]&0xFF;
+
+		// brightest of the four level 1 cells under the coarse cell
+		int r1 = r2<<1;
+		int c1 = c2<<1;
+		for(int dr = 0; dr < 2; dr++) {
+			for(int dc = 0; dc < 2; dc++) {
+				if(pyr->level1[(r2<<1)+dr][(c2<<1)+dc] > pyr->level1[r1][c1]) {
+					r1 = (r2<<1)+dr;
+					c1 = (c2<<1)+dc;
+				}
+			}
+		}
+
+		// centroid of bright pixels around that cell
+		int count = 0;
+		int sumRow = 0;
+		int sumCol = 0;
+		int r0 = Math::max((r1<<1) - REACQ_MARGIN, 0);
+		int c0 = Math::max((c1<<1) - REACQ_MARGIN, 0);
+		int rEnd = Math::min((r1<<1) + 2 + REACQ_MARGIN, VGA_ROWS);
+		int cEnd = Math::min((c1<<1) + 2 + REACQ_MARGIN, VGA_COLUMNS);
+		for(int r = r0; r < rEnd; r++) {
+			volatile unsigned char* px = pixel(r, 0);
+			for(int c = c0; c < cEnd; c++) {
+				if(px[c] > th) {
+					count++;
+					sumRow += r;
+					sumCol += c;
+				}
+			}
+		}
+
+		if(count > bestCount) {
+			bestCount = count;
+			*row = (float)sumRow / (float)count;
+			*col = (float)sumCol / (float)count;
+		}
+	}
+
+	return bestCount > 0;
+}
+
+
+/*
+ * Get the pan and tilt moves (degrees) that bring a target found
+ * to the middle of the region of interest
+ */
+void Tracker::correction(const FrameReport* report, float* pan, float* tilt) {
+	*pan = ((float)COL_MID - report->col) * params->adjPan;
+	*tilt = ((float)ROW_MID - report->row) * params->adjTilt;
+}
+
+/*
+ * Get the threshold that separates the target in the frame
+ */
+unsigned char Tracker::getThreshold() {
+	return threshold;
+}
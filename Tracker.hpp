@@ -0,0 +1,164 @@
+/*
+ * FILENAME:	Tracker.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TRACKER_HPP
+#define TRACKER_HPP
+
+#include "Overlay.hpp"
+#include "Params.hpp"
+#include "Pyramid.hpp"
+#include "FrameReport.h"
+#include "BackgroundModel.hpp"
+#include "EdgeFilter.hpp"
+#include "ColorFilter.hpp"
+#include "TemplateTracker.hpp"
+#include "MultiTracker.hpp"
+#include "Blob.hpp"
+#include "SegmentMode.h"
+#include "TrackerMode.h"
+
+/*
+ * Tracker class, locates the target in a stored frame. Knows nothing
+ * of the camera or servos, so the same code runs on the board after
+ * each capture and on a host over recorded frames.
+ */
+class Tracker {
+private:
+	const TrackerParams* params;
+	Overlay* overlay;
+	BackgroundModel background;
+	EdgeFilter edges;
+	ColorFilter colors;
+	TemplateTracker templ;
+	BlobFinder blobFinder;
+	MultiTracker targets;
+	SegmentMode mode;
+	TrackerMode tracker;
+	bool lockPending;
+	int lockRow;
+	int lockCol;
+	unsigned char threshold;
+
+	// frame being analyzed, rows 1<<VGA_ROW_SHIFT bytes apart
+	volatile unsigned char* frame;
+	Pyramid* pyramid;
+	const unsigned char* uPlane;
+	const unsigned char* vPlane;
+	FrameReport* report;
+
+	/*
+	 * Get a pointer to a pixel of the frame, clamped to the frame
+	 */
+	volatile unsigned char* pixel(int row, int column);
+
+	/*
+	 * Take a point in the frame as the target
+	 */
+	void aimAt(float row, float col);
+
+	/*
+	 * Search the whole frame coarse-to-fine for the brightest object,
+	 * returns false if the frame has no object worth following
+	 */
+	bool reacquire(float* row, float* col);
+
+	/*
+	 * Find the longest horizontal and vertical runs of pixels over
+	 * the threshold, returns false if there is no target in the
+	 * region of interest
+	 */
+	bool findTarget(int* ulr, int* ulc, int* lrr, int* lrc);
+
+	/*
+	 * Follow the reference patch captured when the target was locked
+	 */
+	void trackTemplate();
+
+	/*
+	 * Follow every blob in view and aim at the track the policy selects
+	 */
+	void trackTargets();
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, tracks with the given parameters and records
+	 * annotations in the given overlay
+	 */
+	Tracker(const TrackerParams* params, Overlay* overlay);
+
+	/*
+	 * Take a new frame to analyze, with its downsampled levels,
+	 * chroma planes (only read in colour mode) and the threshold
+	 * halfway through its range, results go to the report
+	 */
+	void begin(volatile unsigned char* frame, Pyramid* pyramid, const unsigned char* u,
+			const unsigned char* v, unsigned char threshold, FrameReport* report);
+
+	/*
+	 * Segment the region of interest and choose the threshold
+	 * that separates the target from the rest of the frame
+	 */
+	void updateThreshold();
+
+	/*
+	 * Find the longest runs in the frame and aim at them
+	 */
+	void findRuns();
+
+	/*
+	 * Locate the target in the frame with the selected tracker,
+	 * frames taken while the mount moved are only reported
+	 */
+	void track(bool steady);
+
+	/*
+	 * Find the centroid of the largest blob in the frame,
+	 * returns false if there is none
+	 */
+	bool locate(float* row, float* col);
+
+	/*
+	 * Get the pan and tilt moves (degrees) that bring a target found
+	 * to the middle of the region of interest
+	 */
+	void correction(const FrameReport* report, float* pan, float* tilt);
+
+	/*
+	 * Get the threshold that separates the target in the frame
+	 */
+	unsigned char getThreshold();
+
+	/*
+	 * Select whether the tracker follows bright, moving, edged or coloured objects
+	 */
+	void setSegmentMode(SegmentMode mode);
+	SegmentMode getSegmentMode();
+
+	/*
+	 * Set the U and V ranges followed in colour mode
+	 */
+	void setColorBox(bool v, unsigned char min, unsigned char max);
+
+	/*
+	 * Select how the target is located in each frame
+	 */
+	void setTrackerMode(TrackerMode tracker);
+
+	/*
+	 * Select which target drives the servos when several are in view
+	 */
+	void setSelectPolicy(SelectPolicy policy);
+
+	/*
+	 * Print the state of every target being followed
+	 */
+	void printTargets();
+};
+
+#endif /* TRACKER_HPP */
@@ -0,0 +1,20 @@
+/*
+ * FILENAME:	TrackerMode.h
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef TRACKERMODE_H
+#define TRACKERMODE_H
+
+/*
+ * TrackerMode enum, determines how the target is located
+ * in each frame once the frame has been segmented
+ */
+enum TrackerMode {
+	TRACKER_RUNS, TRACKER_TEMPLATE, TRACKER_MULTI
+};
+
+typedef enum TrackerMode TrackerMode;
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * FILENAME:	Bench.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, closed-loop benchmark of the tracker on synthetic scenes
+ * whose truth is known. Each frame is rendered where the simulated mount
+ * points, analyzed by the board's tracker and corrected through the
+ * board's PanTilt and servo motion profiles. The servos step every
+ * MOTION_PERIOD_MS, honour the deadband and reach the image a deadtime
+ * late. Accuracy (tracking error, lock losses, settling) is reported
+ * next to the cost of analysis per frame, so a change can be judged on
+ * both. The frames and their truth can be written out for replay and
+ * sweep.
+ *
+ * Build: g++ -O2 -std=c++11 -I.. -o bench Bench.cpp Scene.cpp Score.cpp
+ *        FrameFile.cpp HostClock.cpp HostServo.cpp ../PanTilt.cpp
+ *        ../ServoMotion.cpp ../Tracker.cpp ../Params.cpp ../Pyramid.cpp
+ *        ../BackgroundModel.cpp ../EdgeFilter.cpp ../ColorFilter.cpp
+ *        ../TemplateTracker.cpp ../Blob.cpp ../MultiTracker.cpp
+ *        ../Overlay.cpp ../Arena.cpp
+ * Usage: bench [-s scene] [-n frames] [-f fps] [-d deadtime_ms] [-r seed]
+ *        [-o frames.pgm truth.csv] [NAME=value ...]
+ */
+
+#include "Scene.hpp"
+#include "Score.hpp"
+#include "FrameFile.hpp"
+#include "PanTilt.hpp"
+#include "Tracker.hpp"
+#include "Params.hpp"
+#include "Pyramid.hpp"
+#include "Overlay.hpp"
+#include "Clock.hpp"
+#include "Arena.hpp"
+#include "Math.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define DEFAULT_FRAMES 600
+#define DEFAULT_FPS 20
+
+// Distance of the target from the middle of the region of interest
+// that counts as centred, pixels, and frames it must stay there
+#define CENTRED_PX 3.0f
+#define CENTRED_FRAMES 5
+
+// Profile steps of servo output kept for the deadtime (power of two)
+#define PLANT_HISTORY 1024
+
+/*
+ * Options struct, how every scene is run
+ */
+struct Options {
+	int frames;
+	int fps;
+	int deadtime;
+	unsigned int seed;
+	FILE* frameOut;
+	FILE* truthOut;
+};
+
+static unsigned char frame[FRAME_BYTES];
+static unsigned char blank[VGA_ROWS*VGA_COLUMNS];
+static Pyramid pyramid;
+
+// servo output, after the deadband, by profile step
+static int plantPan[PLANT_HISTORY];
+static int plantTilt[PLANT_HISTORY];
+
+// frames written out, numbering the truth lines
+static int written = 0;
+
+/*
+ * Write a frame and its truth for replay and sweep
+ */
+static void save(const Options* opt, bool visible, float row, float col) {
+	fprintf(opt->frameOut, "P5\n%d %d\n255\n", VGA_COLUMNS, VGA_ROWS);
+	for(int r = 0; r < VGA_ROWS; r++)
+		fwrite(frame + (r << VGA_ROW_SHIFT), 1, VGA_COLUMNS, opt->frameOut);
+	fprintf(opt->truthOut, "%d,%d,%.2f,%.2f\n", written++, visible ? 1 : 0, row, col);
+}
+
+/*
+ * Run one scene in closed loop and print a line of results
+ */
+static void run(int preset, const TrackerParams* params, const Options* opt) {
+	Scene scene(preset, opt->seed);
+	PanTilt mount(params);
+	Overlay overlay;
+	overlay.enable(false);
+	Tracker tracker(params, &overlay);
+	FrameReport report;
+	Score score;
+
+	// home, as after reset
+	mount.pan(0.0f);
+	mount.tilt(90.0f);
+	ServoMotion* servoPan = mount.getPanServo();
+	ServoMotion* servoTilt = mount.getTiltServo();
+	int outPan = servoPan->countAt(servoPan->getStep());
+	int outTilt = servoTilt->countAt(servoTilt->getStep());
+	for(int i = 0; i < PLANT_HISTORY; i++) {
+		plantPan[i] = outPan;
+		plantTilt[i] = outTilt;
+	}
+	mount.placeFrame(mount.getStep(), mount.getStep());
+
+	int periodSteps = Math::max(1000 / opt->fps / MOTION_PERIOD_MS, 1);
+	int delaySteps = Math::clamp(opt->deadtime / MOTION_PERIOD_MS, 0, PLANT_HISTORY - periodSteps - 1);
+
+	unsigned int skipped = 0;
+	unsigned int aimed = 0;
+	double aimSum = 0.0;
+	int centred = 0;
+	int settleFrame = -1;
+	unsigned int worst = 0;
+	unsigned long long total = 0;
+
+	for(int f = 0; f < opt->frames; f++) {
+		// the motion engine steps both profiles through the frame, and
+		// the output stage holds back changes inside the deadband until
+		// the motion ends
+		unsigned int from = mount.getStep();
+		for(int i = 0; i < periodSteps; i++) {
+			int pan = servoPan->step();
+			int tilt = servoTilt->step();
+			if(Math::abs(pan - outPan) > params->servoDeadband || servoPan->isSettled())
+				outPan = pan;
+			if(Math::abs(tilt - outTilt) > params->servoDeadband || servoTilt->isSettled())
+				outTilt = tilt;
+			plantPan[servoPan->getStep() & (PLANT_HISTORY-1)] = outPan;
+			plantTilt[servoTilt->getStep() & (PLANT_HISTORY-1)] = outTilt;
+		}
+		unsigned int to = mount.getStep();
+
+		// the image shows the mount where the output was a deadtime ago
+		unsigned int mid = from + (to - from) / 2;
+		unsigned int seen = (mid - delaySteps) & (PLANT_HISTORY-1);
+		float pan = mount.panDegrees(plantPan[seen] * (1.0f / PWM_MAX_COUNT));
+		float tilt = mount.tiltDegrees(plantTilt[seen] * (1.0f / PWM_MAX_COUNT));
+		float t = mid * MOTION_PERIOD_MS / 1000.0f;
+
+		float row, col;
+		bool visible = scene.render(t, pan, tilt, frame, &row, &col);
+		if(opt->frameOut != NULL)
+			save(opt, visible, row, col);
+
+		// what the capture loop leaves behind with a frame
+		unsigned char min = 255;
+		unsigned char max = 0;
+		for(int r = 0; r < VGA_ROWS; r++) {
+			for(int c = 0; c < VGA_COLUMNS; c++) {
+				unsigned char px = frame[(r << VGA_ROW_SHIFT) + c];
+				min = px < min ? px : min;
+				max = px > max ? px : max;
+			}
+		}
+		pyramid.build(frame);
+		mount.placeFrame(from, to);
+
+		// analysis is what the benchmark times, as on the board
+		Arena::reset();
+		unsigned int start = Clock::now();
+		report.captured = start;
+		tracker.begin(frame, &pyramid, blank, blank, (min>>1) + (max>>1), &report);
+		tracker.track(mount.isSteady());
+		unsigned int us = Clock::toMicros(Clock::now() - start);
+		worst = us > worst ? us : worst;
+		total += us;
+		overlay.render(frame);
+
+		// control, as CameraMount::control
+		if(report.found) {
+			float adjPan, adjTilt;
+			tracker.correction(&report, &adjPan, &adjTilt);
+			mount.tilt(mount.getFrameTilt() + adjTilt);
+			mount.pan(mount.getFramePan() + adjPan);
+		}
+
+		// frames taken while moving are not analyzed, so not scored
+		if(mount.isSteady())
+			score.add(visible, row, col, &report);
+		else
+			skipped++;
+
+		// how well the loop keeps the target where it aims it
+		float aim = 1e9f;
+		if(visible) {
+			float dr = row - (params->rowEnd + params->rowStart) / 2;
+			float dc = col - (params->colEnd + params->colStart) / 2;
+			aim = sqrtf(dr*dr + dc*dc);
+			aimSum += aim;
+			aimed++;
+		}
+		centred = aim <= CENTRED_PX ? centred + 1 : 0;
+		if(settleFrame < 0 && centred >= CENTRED_FRAMES)
+			settleFrame = f - (CENTRED_FRAMES - 1);
+	}
+
+	float frameMs = periodSteps * MOTION_PERIOD_MS;
+	printf("%s,%d,%u,%.2f,%.2f,%u,%u,%u,%.0f,", Scene::name(preset), opt->frames, skipped,
+			score.meanError(), aimed != 0 ? (float)(aimSum / aimed) : 0.0f,
+			score.getLost(), score.getFalse(), score.getLockLosses(), score.meanSettle() * frameMs);
+	if(settleFrame >= 0)
+		printf("%.0f,", settleFrame * frameMs);
+	else
+		printf("never,");
+	printf("%.1f,%u\n", opt->frames != 0 ? (float)total / opt->frames : 0.0f, worst);
+}
+
+/*
+ * Main function, runs every scene, or the one asked for
+ */
+int main(int argc, char** argv) {
+	TrackerParams params;
+	Params::defaults(&params);
+
+	Options opt;
+	opt.frames = DEFAULT_FRAMES;
+	opt.fps = DEFAULT_FPS;
+	opt.deadtime = -1;
+	opt.seed = 1;
+	opt.frameOut = NULL;
+	opt.truthOut = NULL;
+	int only = -1;
+
+	for(int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		bool value = i + 1 < argc;
+		if(strcmp(arg, "-s") == 0 && value) {
+			only = Scene::find(argv[++i]);
+			if(only < 0) {
+				fprintf(stderr, "ERROR: Unknown scene %s\n", argv[i]);
+				return 1;
+			}
+		} else if(strcmp(arg, "-n") == 0 && value) {
+			opt.frames = atoi(argv[++i]);
+		} else if(strcmp(arg, "-f") == 0 && value) {
+			opt.fps = Math::clamp(atoi(argv[++i]), 1, 1000 / MOTION_PERIOD_MS);
+		} else if(strcmp(arg, "-d") == 0 && value) {
+			opt.deadtime = atoi(argv[++i]);
+		} else if(strcmp(arg, "-r") == 0 && value) {
+			opt.seed = atoi(argv[++i]);
+		} else if(strcmp(arg, "-o") == 0 && i + 2 < argc) {
+			opt.frameOut = fopen(argv[++i], "wb");
+			opt.truthOut = fopen(argv[++i], "w");
+			if(opt.frameOut == NULL || opt.truthOut == NULL) {
+				fprintf(stderr, "ERROR: Cannot write %s\n", argv[i]);
+				return 1;
+			}
+			fprintf(opt.truthOut, "frame,visible,row,col\n");
+		} else {
+			char name[64];
+			const char* eq = strchr(arg, '=');
+			if(eq == NULL || eq - arg >= (int)sizeof(name)) {
+				fprintf(stderr, "ERROR: Expected NAME=value, got %s\n", arg);
+				return 1;
+			}
+			memcpy(name, arg, eq - arg);
+			name[eq - arg] = '\0';
+			if(!Params::set(&params, name, atof(eq + 1))) {
+				fprintf(stderr, "ERROR: Cannot set %s\n", arg);
+				return 1;
+			}
+		}
+	}
+
+	// unless told otherwise the servos are as late as the tracker thinks
+	if(opt.deadtime < 0)
+		opt.deadtime = params.servoDeadtime;
+
+	Clock::init();
+	printf("scene,frames,skipped,error_px,aim_px,lost,false,lock_losses,lock_ms,settle_ms,track_us,worst_us\n");
+	for(int i = 0; Scene::name(i) != NULL; i++) {
+		if(only < 0 || only == i)
+			run(i, &params, &opt);
+	}
+
+	if(opt.frameOut != NULL) {
+		fclose(opt.frameOut);
+		fclose(opt.truthOut);
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * FILENAME:	FrameFile.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "FrameFile.hpp"
+
+/*
+ * Read a number from a PGM header, skipping whitespace and comments,
+ * returns -1 at the end of the file
+ */
+static int headerField(FILE* in) {
+	int ch = fgetc(in);
+	while(ch == '#' || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') {
+		if(ch == '#')
+			while(ch != '\n' && ch != EOF)
+				ch = fgetc(in);
+		ch = fgetc(in);
+	}
+
+	int value = -1;
+	while(ch >= '0' && ch <= '9') {
+		value = (value < 0 ? 0 : value*10) + ch - '0';
+		ch = fgetc(in);
+	}
+	// one whitespace character ends the field, and the header
+	return value;
+}
+
+/*
+ * Read the next frame into FRAME_BYTES laid out as in the VGA
+ * memory, scaled to 8 bits, and get the threshold the capture
+ * loop leaves with it, returns false at the end of the recording
+ * or if the frame is not 80x60
+ */
+bool FrameFile::read(FILE* in, unsigned char* frame, unsigned char* threshold) {
+	int maxval = 255;
+
+	int ch = fgetc(in);
+	if(ch == EOF)
+		return false;
+	if(ch == 'P') {
+		if(fgetc(in) != '5' || headerField(in) != VGA_COLUMNS || headerField(in) != VGA_ROWS ||
+				(maxval = headerField(in)) <= 0 || maxval > 255) {
+			fprintf(stderr, "ERROR: Frames must be 8 bit %dx%d P5 images\n", VGA_COLUMNS, VGA_ROWS);
+			return false;
+		}
+	} else {
+		ungetc(ch, in);
+	}
+
+	unsigned char min = 255;
+	unsigned char max = 0;
+	for(int r = 0; r < VGA_ROWS; r++) {
+		unsigned char* row = frame + (r << VGA_ROW_SHIFT);
+		if(fread(row, 1, VGA_COLUMNS, in) != VGA_COLUMNS)
+			return false;
+
+		for(int c = 0; c < VGA_COLUMNS; c++) {
+			if(maxval != 255)
+				row[c] = row[c] * 255 / maxval;
+			min = row[c] < min ? row[c] : min;
+			max = row[c] > max ? row[c] : max;
+		}
+	}
+
+	*threshold = (min>>1) + (max>>1);
+	return true;
+}
@@ -0,0 +1,32 @@
+/*
+ * FILENAME:	FrameFile.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef FRAMEFILE_HPP
+#define FRAMEFILE_HPP
+
+#include "Camera.hpp"
+
+#include <stdio.h>
+
+// Bytes of a frame laid out as in the VGA memory
+#define FRAME_BYTES (VGA_ROWS << VGA_ROW_SHIFT)
+
+/*
+ * FrameFile namespace, reads recorded frames for the host tools.
+ * A recording is P5 PGM images (any maxval, as written by
+ * preview_view) or raw 80x60 bytes, concatenated.
+ */
+namespace FrameFile {
+	/*
+	 * Read the next frame into FRAME_BYTES laid out as in the VGA
+	 * memory, scaled to 8 bits, and get the threshold the capture
+	 * loop leaves with it, returns false at the end of the recording
+	 * or if the frame is not 80x60
+	 */
+	bool read(FILE* in, unsigned char* frame, unsigned char* threshold);
+}
+
+#endif /* FRAMEFILE_HPP */
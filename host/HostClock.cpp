@@ -0,0 +1,37 @@
+/*
+ * FILENAME:	HostClock.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Clock for the host tools, counts the same 50 MHz ticks as the board's
+ * timer from the host's steady clock, so tracker code that timestamps
+ * its reports links and runs unchanged.
+ */
+
+#include "Clock.hpp"
+
+#include <chrono>
+
+static std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+/*
+ * Start the counter
+ */
+void Clock::init() {
+	epoch = std::chrono::steady_clock::now();
+}
+
+/*
+ * Get the current timestamp in CPU clock ticks
+ */
+unsigned int Clock::now() {
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - epoch;
+	return (unsigned int)(elapsed.count() * CLOCK_TICKS_PER_US / 1000);
+}
+
+/*
+ * Convert a tick interval to microseconds
+ */
+unsigned int Clock::toMicros(unsigned int ticks) {
+	return ticks / CLOCK_TICKS_PER_US;
+}
@@ -0,0 +1,78 @@
+/*
+ * FILENAME:	HostServo.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * PWM and Servo for the host tools, keep the count set without a PWM
+ * component to write it to, so the servo motion profiles link and run
+ * unchanged in simulation.
+ */
+
+#include "Servo.hpp"
+#include "Math.hpp"
+
+/*
+ * Constructor, base address and which half of the PWM
+ * module to control
+ */
+PWM::PWM(int address, PWMIndex index) : PWM(address, index, 0.0f) { }
+
+/*
+ * Constructor, also specify initial duty cycle
+ */
+PWM::PWM(int address, PWMIndex index, float dc) : address(address), index(index) {
+	setDC(dc);
+}
+
+/*
+ * Sets duty cycle as a value from 0.0 to 1.0
+ */
+void PWM::setDC(float dc) {
+	dc = Math::clamp<float>(dc, 0.0, 1.0);
+	setCount((int)(dc*PWM_MAX_COUNT));
+}
+
+/*
+ * Gets the set duty cycle
+ */
+float PWM::getDC() {
+	return count * (1.0f / PWM_MAX_COUNT);
+}
+
+/*
+ * Sets duty cycle as a count out of PWM_MAX_COUNT
+ */
+void PWM::setCount(int count) {
+	this->count = count;
+}
+
+/*
+ * Gets the set duty cycle as a count
+ */
+int PWM::getCount() {
+	return count;
+}
+
+/*
+ * Constructor, which half of the Servo module to control
+ */
+Servo::Servo(PWMIndex index) : PWM(0, index, 0.0f) { }
+
+/*
+ * Constructor, initial position
+ */
+Servo::Servo(PWMIndex index, float position) : PWM(0, index, position) { }
+
+/*
+ * Gets the set position
+ */
+float Servo::getPosition() {
+	return this->getDC();
+}
+
+/*
+ * Sets position as a value from 0.0 to 1.0
+ */
+void Servo::setPosition(float position) {
+	this->setDC(position);
+}
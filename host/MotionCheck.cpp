@@ -0,0 +1,132 @@
+/*
+ * FILENAME:	MotionCheck.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, checks the servo motion profile. Moves from rest must
+ * approach the target without ever passing it, and no sequence of
+ * targets within the pan limits, however often it changes mid-move,
+ * may drive the output outside them. The limits are set as PanTilt
+ * sets them. Exits non-zero on a failure.
+ *
+ * Build: g++ -O2 -std=c++11 -I.. -o motioncheck MotionCheck.cpp
+ *        HostServo.cpp ../ServoMotion.cpp ../Params.cpp
+ * Usage: motioncheck [-r seed] [-n moves]
+ */
+
+#include "ServoMotion.hpp"
+#include "Params.hpp"
+#include "Math.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_MOVES 20000
+
+// Steps allowed for any move to settle, the full travel takes under a second
+#define SETTLE_STEPS 400
+
+static unsigned int seed = 1;
+
+/*
+ * Get a uniform random number in [0,1)
+ */
+static float uniform() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return (seed >> 8) * (1.0f / (1 << 24));
+}
+
+/*
+ * Get the count a duty cycle target is held at
+ */
+static int countOf(float dc) {
+	return (int)(Math::clamp<float>(dc, 0.0f, 1.0f) * PWM_MAX_COUNT);
+}
+
+/*
+ * Move from rest to each target in turn, returns the number of moves
+ * that passed their target or did not settle
+ */
+static int checkRest(const TrackerParams* params, int moves) {
+	ServoMotion servo(PWMINDEX_A);
+	servo.setLimits(params->panMin, params->panMax);
+	servo.setTarget(params->panMin);
+	int failures = 0;
+
+	for(int m = 0; m < moves; m++) {
+		int from = servo.countAt(servo.getStep());
+		float dc = params->panMin + (params->panMax - params->panMin) * uniform();
+		int to = countOf(dc);
+		servo.setTarget(dc);
+
+		int worst = 0;
+		int s = 0;
+		for(; s < SETTLE_STEPS && !servo.isSettled(); s++) {
+			int count = servo.step();
+			int past = to > from ? count - to : to - count;
+			worst = Math::max(worst, past);
+		}
+		if(worst > 0 || !servo.isSettled()) {
+			if(failures++ < 10)
+				printf("FAIL rest move %d -> %d passed by %d, %s\n", from, to, worst,
+						servo.isSettled() ? "settled" : "never settled");
+		}
+	}
+	return failures;
+}
+
+/*
+ * Change the target at random moments, mid-move included, returns
+ * the number of steps that output a count outside the limits
+ */
+static int checkLimits(const TrackerParams* params, int moves) {
+	ServoMotion servo(PWMINDEX_A);
+	servo.setLimits(params->panMin, params->panMax);
+	servo.setTarget(params->panMin);
+	int lo = countOf(params->panMin);
+	int hi = countOf(params->panMax);
+	int failures = 0;
+
+	for(int m = 0; m < moves; m++) {
+		// mostly toward the ends of the travel, where passing matters
+		float u = uniform();
+		float dc = u < 0.4f ? params->panMin : (u < 0.8f ? params->panMax :
+				params->panMin + (params->panMax - params->panMin) * uniform());
+		servo.setTarget(dc);
+
+		int steps = 1 + (int)(uniform() * 60);
+		for(int s = 0; s < steps; s++) {
+			int count = servo.step();
+			if(count < lo || count > hi) {
+				if(failures++ < 10)
+					printf("FAIL count %d outside %d-%d\n", count, lo, hi);
+			}
+		}
+	}
+	return failures;
+}
+
+/*
+ * Main function, runs both checks
+ */
+int main(int argc, char** argv) {
+	int moves = DEFAULT_MOVES;
+	for(int i = 1; i + 1 < argc; i += 2) {
+		if(strcmp(argv[i], "-r") == 0)
+			seed = atoi(argv[i+1]) != 0 ? atoi(argv[i+1]) : 1;
+		else if(strcmp(argv[i], "-n") == 0)
+			moves = atoi(argv[i+1]);
+	}
+
+	TrackerParams params;
+	Params::defaults(&params);
+
+	int rest = checkRest(&params, moves);
+	int limits = checkLimits(&params, moves);
+	printf("%d moves from rest, %d passed the target\n", moves, rest);
+	printf("%d target changes, %d steps outside the limits\n", moves, limits);
+	return rest == 0 && limits == 0 ? 0 : 1;
+}
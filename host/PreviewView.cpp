@@ -0,0 +1,187 @@
+/*
+ * FILENAME:	PreviewView.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, rebuilds the live preview from a capture of the JTAG UART
+ * stream (or nios2-terminal piped in directly). Each complete frame is
+ * drawn as text, and written as a PGM image if a directory is given.
+ * Telemetry records and console text mixed into the stream are skipped.
+ *
+ * Build: g++ -O2 -I.. -o preview_view PreviewView.cpp
+ * Usage: preview_view [capture.bin|-] [outdir]
+ */
+
+#include "PreviewChunk.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// Frame size, as in the VGA memory
+#define FRAME_ROWS 60
+#define FRAME_COLUMNS 80
+#define FRAME_PIXELS (FRAME_ROWS*FRAME_COLUMNS)
+
+// Largest encoding of a frame, every pixel a literal
+#define ENCODED_MAX (FRAME_PIXELS + FRAME_PIXELS/128 + 1)
+
+// Characters from dark to bright for the text view
+static const char ramp[] = " .:-=+*#%@";
+
+static unsigned char encoded[ENCODED_MAX];
+static unsigned char image[FRAME_PIXELS];
+
+/*
+ * Apply an encoded frame to the image, returns false if the
+ * encoding does not cover the frame exactly
+ */
+static bool decode(int length, bool key) {
+	if(key)
+		memset(image, 0, sizeof(image));
+
+	int px = 0;
+	int i = 0;
+	while(i < length) {
+		unsigned char token = encoded[i++];
+		int run = (token & 0x7F) + 1;
+		if(px + run > FRAME_PIXELS)
+			return false;
+
+		if(token & 0x80) {
+			if(i + run > length)
+				return false;
+			for(int k = 0; k < run; k++, px++)
+				image[px] = (image[px] + encoded[i++]) & (PREVIEW_LEVELS-1);
+		} else {
+			px += run;
+		}
+	}
+
+	return px == FRAME_PIXELS;
+}
+
+/*
+ * Draw the image as text, two frame rows per line
+ */
+static void draw(int frame, bool mask) {
+	printf("\n-- frame %d%s --\n", frame, mask ? " (mask)" : "");
+	for(int r = 0; r < FRAME_ROWS; r += 2) {
+		for(int c = 0; c < FRAME_COLUMNS; c++) {
+			int v = (image[r*FRAME_COLUMNS + c] + image[(r+1)*FRAME_COLUMNS + c]) / 2;
+			putchar(ramp[v * (sizeof(ramp) - 2) / (PREVIEW_LEVELS-1)]);
+		}
+		putchar('\n');
+	}
+	fflush(stdout);
+}
+
+/*
+ * Write the image as a PGM file
+ */
+static void save(const char* dir, int count) {
+	char name[512];
+	snprintf(name, sizeof(name), "%s/preview%05d.pgm", dir, count);
+
+	FILE* out = fopen(name, "wb");
+	if(out == NULL) {
+		fprintf(stderr, "ERROR: Cannot write %s\n", name);
+		return;
+	}
+
+	fprintf(out, "P5\n%d %d\n%d\n", FRAME_COLUMNS, FRAME_ROWS, PREVIEW_LEVELS-1);
+	fwrite(image, 1, sizeof(image), out);
+	fclose(out);
+}
+
+/*
+ * Main function, scans the stream for chunks and shows each frame
+ */
+int main(int argc, char** argv) {
+	FILE* in = (argc > 1 && strcmp(argv[1], "-") != 0) ? fopen(argv[1], "rb") : stdin;
+	if(in == NULL) {
+		fprintf(stderr, "ERROR: Cannot open %s\n", argv[1]);
+		return 1;
+	}
+	const char* dir = argc > 2 ? argv[2] : NULL;
+
+	unsigned char chunk[sizeof(PreviewHeader) + PREVIEW_CHUNK_DATA];
+	unsigned int fill = 0;
+	unsigned int frames = 0;
+	unsigned int dropped = 0;
+
+	// frame being reassembled, and the last one applied to the image
+	int current = -1;
+	int received = 0;
+	int shown = -1;
+	int ch;
+
+	while((ch = fgetc(in)) != EOF) {
+		chunk[fill++] = ch;
+
+		// wait for the sync and the rest of the header
+		if(fill == 2 && (chunk[0] | chunk[1]<<8) != PREVIEW_SYNC) {
+			chunk[0] = chunk[1];
+			fill = 1;
+			continue;
+		}
+		if(fill < sizeof(PreviewHeader))
+			continue;
+
+		PreviewHeader h;
+		memcpy(&h, chunk, sizeof(h));
+		unsigned int size = sizeof(PreviewHeader) + h.length;
+
+		unsigned char sum = 0;
+		bool bad = h.sync != PREVIEW_SYNC || h.length > PREVIEW_CHUNK_DATA || h.offset + h.length > ENCODED_MAX;
+		if(!bad && fill < size)
+			continue;
+		for(unsigned int i = 0; !bad && i < size; i++)
+			sum += chunk[i];
+
+		// not a chunk here, slide one byte and keep looking
+		if(bad || sum != 0) {
+			memmove(chunk, chunk + 1, --fill);
+			continue;
+		}
+		fill = 0;
+
+		// a chunk of a new frame abandons any incomplete one
+		if(h.frame != current) {
+			if(current >= 0 && received != 0)
+				dropped++;
+			current = h.frame;
+			received = 0;
+		}
+
+		// chunks arrive in order, a gap loses the frame
+		if(h.offset != received) {
+			received = -1;
+			continue;
+		}
+		memcpy(encoded + h.offset, chunk + sizeof(PreviewHeader), h.length);
+		received += h.length;
+
+		if(!(h.flags & PREVIEW_LAST))
+			continue;
+
+		// a difference frame needs the one before it
+		bool key = (h.flags & PREVIEW_KEY) != 0;
+		if(!key && (shown < 0 || ((shown + 1) & 0xFF) != current)) {
+			dropped++;
+			shown = -1;
+		} else if(decode(received, key)) {
+			shown = current;
+			draw(current, (h.flags & PREVIEW_MASK) != 0);
+			if(dir != NULL)
+				save(dir, frames);
+			frames++;
+		} else {
+			dropped++;
+			shown = -1;
+		}
+		received = 0;
+	}
+
+	fprintf(stderr, "%u frames, %u dropped\n", frames, dropped);
+	return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * FILENAME:	Replay.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, runs the board's tracker over recorded frames as a three
+ * stage pipeline: decode, analysis and control each on their own thread,
+ * handing preallocated frame slots along lock-free rings, so a corpus
+ * replays at host speed with the exact tracker code the board runs.
+ * Recordings are read as FrameFile.hpp describes, one CSV line is
+ * written per frame. Recordings hold no chroma, so colour segmentation
+ * cannot be replayed and is refused.
+ *
+ * Build: g++ -O2 -std=c++11 -pthread -I.. -o replay Replay.cpp FrameFile.cpp HostClock.cpp
+ *        ../Tracker.cpp ../Params.cpp ../Pyramid.cpp ../BackgroundModel.cpp
+ *        ../EdgeFilter.cpp ../ColorFilter.cpp ../TemplateTracker.cpp
+ *        ../Blob.cpp ../MultiTracker.cpp ../Overlay.cpp ../Arena.cpp
+ * Usage: replay [frames|-] [-m BRIGHT|MOTION|EDGE] [NAME=value ...] > track.csv
+ */
+
+#include "Ring.hpp"
+#include "FrameFile.hpp"
+#include "Tracker.hpp"
+#include "Params.hpp"
+#include "Pyramid.hpp"
+#include "Overlay.hpp"
+#include "Clock.hpp"
+#include "Arena.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+// Frames in flight between the stages
+#define SLOTS 8
+// Ring capacity, holds every slot with one entry to spare
+#define RING_SIZE 16
+
+/*
+ * Slot struct, one frame and everything the stages add to it
+ */
+struct Slot {
+	// frame as in the VGA memory, rows 1<<VGA_ROW_SHIFT bytes apart
+	unsigned char frame[FRAME_BYTES];
+	Pyramid pyramid;
+	unsigned char threshold;
+	FrameReport report;
+	// position in the recording, negative once it has ended
+	int index;
+};
+
+typedef Ring<Slot*, RING_SIZE> SlotRing;
+
+static Slot slots[SLOTS];
+static SlotRing freeSlots;
+static SlotRing decoded;
+static SlotRing analyzed;
+
+// Segment modes by console name, as MODE takes them
+static const char* const segmentKeys[] = { "BRIGHT", "MOTION", "EDGE", "COLOR", NULL };
+
+// chroma planes, only read in colour mode, which replay refuses
+static unsigned char blank[VGA_ROWS*VGA_COLUMNS];
+
+static TrackerParams params;
+static Overlay overlay;
+static Tracker tracker(&params, &overlay);
+
+static FILE* in;
+
+/*
+ * Hand a slot to the next stage, waiting while it is behind
+ */
+static void send(SlotRing* ring, Slot* slot) {
+	while(!ring->push(slot))
+		std::this_thread::yield();
+}
+
+/*
+ * Take the next slot from the stage before, waiting until there is one
+ */
+static Slot* receive(SlotRing* ring) {
+	Slot* slot;
+	while(!ring->pop(&slot))
+		std::this_thread::yield();
+	return slot;
+}
+
+/*
+ * Decode stage, fills free slots from the recording
+ */
+static void decode() {
+	for(int index = 0; ; index++) {
+		Slot* slot = receive(&freeSlots);
+		slot->report.start = Clock::now();
+		bool ended = !FrameFile::read(in, slot->frame, &slot->threshold);
+		if(!ended)
+			slot->pyramid.build(slot->frame);
+		slot->index = ended ? -1 : index;
+
+		// the slot belongs to the next stage once it is sent
+		send(&decoded, slot);
+		if(ended)
+			return;
+	}
+}
+
+/*
+ * Analysis stage, runs the tracker over each frame
+ */
+static void analyze() {
+	for(;;) {
+		Slot* slot = receive(&decoded);
+		bool ended = slot->index < 0;
+		if(!ended) {
+			// a recording holds no servo motion, every frame is steady
+			Arena::reset();
+			slot->report.captured = Clock::now();
+			tracker.begin(slot->frame, &slot->pyramid, blank, blank, slot->threshold, &slot->report);
+			tracker.track(true);
+			overlay.render(slot->frame);
+		}
+		send(&analyzed, slot);
+		if(ended)
+			return;
+	}
+}
+
+/*
+ * Main function, starts the stages and runs control on this thread,
+ * printing the correction the board would have sent for each frame
+ */
+int main(int argc, char** argv) {
+	in = (argc > 1 && strcmp(argv[1], "-") != 0) ? fopen(argv[1], "rb") : stdin;
+	if(in == NULL) {
+		fprintf(stderr, "ERROR: Cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	Params::defaults(&params);
+	for(int i = 2; i < argc; i++) {
+		if(strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+			int mode = 0;
+			while(segmentKeys[mode] != NULL && strcmp(argv[i+1], segmentKeys[mode]) != 0)
+				mode++;
+			if(segmentKeys[mode] == NULL) {
+				fprintf(stderr, "ERROR: Unknown segment mode %s\n", argv[i+1]);
+				return 1;
+			}
+			if(mode == SEGMENT_COLOR) {
+				fprintf(stderr, "ERROR: Recordings hold no U/V planes, colour mode cannot be replayed\n");
+				return 1;
+			}
+			tracker.setSegmentMode((SegmentMode)mode);
+			i++;
+			continue;
+		}
+
+		char name[64];
+		const char* eq = strchr(argv[i], '=');
+		if(eq == NULL || eq - argv[i] >= (int)sizeof(name)) {
+			fprintf(stderr, "ERROR: Expected NAME=value, got %s\n", argv[i]);
+			return 1;
+		}
+		memcpy(name, argv[i], eq - argv[i]);
+		name[eq - argv[i]] = '\0';
+		if(!Params::set(&params, name, atof(eq + 1))) {
+			fprintf(stderr, "ERROR: Cannot set %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	// annotations are cleared every frame but never drawn
+	overlay.enable(false);
+	Clock::init();
+
+	for(int i = 0; i < SLOTS; i++)
+		freeSlots.push(&slots[i]);
+
+	std::thread decoder(decode);
+	std::thread analyzer(analyze);
+
+	unsigned int start = Clock::now();
+	unsigned int frames = 0;
+	unsigned int found = 0;
+	unsigned int worst = 0;
+	unsigned long long total = 0;
+
+	printf("frame,found,row,col,threshold,pan,tilt,analyze_us\n");
+	for(;;) {
+		Slot* slot = receive(&analyzed);
+		if(slot->index < 0)
+			break;
+
+		FrameReport* report = &slot->report;
+		float pan = 0.0f;
+		float tilt = 0.0f;
+		if(report->found) {
+			tracker.correction(report, &pan, &tilt);
+			found++;
+		}
+		report->controlled = Clock::now();
+		report->pan = pan;
+		report->tilt = tilt;
+
+		unsigned int us = Clock::toMicros(report->analyzed - report->captured);
+		worst = us > worst ? us : worst;
+		total += us;
+		frames++;
+
+		printf("%d,%d,%.2f,%.2f,%d,%.3f,%.3f,%u\n", slot->index, report->found ? 1 : 0,
+				report->found ? report->row : 0.0f, report->found ? report->col : 0.0f,
+				report->threshold, pan, tilt, us);
+		send(&freeSlots, slot);
+	}
+
+	decoder.join();
+	analyzer.join();
+
+	float seconds = Clock::toMicros(Clock::now() - start) / 1000000.0f;
+	fprintf(stderr, "%u frames, target found in %u, %.1f fps, analysis %.0f us mean %u us worst\n",
+			frames, found, seconds > 0.0f ? frames / seconds : 0.0f,
+			frames != 0 ? (float)total / frames : 0.0f, worst);
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * FILENAME:	Ring.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef RING_HPP
+#define RING_HPP
+
+#include <atomic>
+
+/*
+ * Ring class, lock-free queue between exactly one producer thread and
+ * one consumer thread. Holds up to SIZE-1 items, SIZE a power of two.
+ * Items are copied in and out, pass pointers to preallocated buffers
+ * so nothing is allocated per item.
+ */
+template <typename T, unsigned int SIZE> class Ring {
+private:
+	T items[SIZE];
+
+	// head is only written by the consumer and tail by the producer,
+	// kept on separate cache lines so they do not bounce between cores
+	alignas(64) std::atomic<unsigned int> head;
+	alignas(64) std::atomic<unsigned int> tail;
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, ring starts empty
+	 */
+	Ring() : head(0), tail(0) {
+		static_assert((SIZE & (SIZE - 1)) == 0, "ring size must be a power of two");
+	}
+
+	/*
+	 * Add an item, producer only, returns false if the ring is full
+	 */
+	bool push(const T& item) {
+		unsigned int t = tail.load(std::memory_order_relaxed);
+		unsigned int next = (t + 1) & (SIZE - 1);
+		if(next == head.load(std::memory_order_acquire))
+			return false;
+
+		items[t] = item;
+		tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/*
+	 * Take the oldest item, consumer only, returns false if the ring is empty
+	 */
+	bool pop(T* item) {
+		unsigned int h = head.load(std::memory_order_relaxed);
+		if(h == tail.load(std::memory_order_acquire))
+			return false;
+
+		*item = items[h];
+		head.store((h + 1) & (SIZE - 1), std::memory_order_release);
+		return true;
+	}
+};
+
+#endif /* RING_HPP */
@@ -0,0 +1,220 @@
+/*
+ * FILENAME:	Scene.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Scene.hpp"
+#include "Math.hpp"
+
+#include <math.h>
+#include <string.h>
+#include <stddef.h>
+
+#define PI 3.14159265f
+
+// Pixel the middle of the view falls on
+#define VIEW_ROW ((VGA_ROWS-1) / 2.0f)
+#define VIEW_COL ((VGA_COLUMNS-1) / 2.0f)
+
+// Middle of the target's path, degrees, off the middle of the view
+// from home (pan 0, tilt 90) so every run starts by settling on it
+#define PATH_AZ 6.0f
+#define PATH_EL 84.0f
+
+// Size (pixels) and brightness of the target and the distractors
+#define TARGET_RADIUS 3.0f
+#define TARGET_LEVEL 220
+#define DISTRACTOR_RADIUS 1.5f
+#define DISTRACTOR_LEVEL 170
+#define CROSSER_RADIUS 2.5f
+#define CROSSER_LEVEL 150
+
+// Seconds between target occlusions, and how long each lasts
+#define OCCLUDE_PERIOD 5.0f
+#define OCCLUDE_TIME 0.6f
+
+// Seconds for the lighting to swell and fade, and for the crossing
+// distractor to pass
+#define LIGHT_PERIOD 6.0f
+#define CROSS_PERIOD 6.0f
+
+/*
+ * Preset struct, what a scene puts in front of the camera
+ */
+struct Preset {
+	const char* name;
+	// half the width of the target's path, degrees, zero holds it still
+	float amplitude;
+	// seconds to go once round the path
+	float period;
+	// sensor noise, standard deviation in grey levels
+	float noise;
+	// static distractors, one more crosses the view if there are any
+	int distractors;
+	// depth of the lighting changes, 0 to 1
+	float light;
+	// whether the target is hidden for a moment now and then
+	bool occlude;
+};
+
+static const Preset presets[] = {
+	{ "still", 0.0f, 1.0f, 2.0f, 0, 0.0f, false },
+	{ "slow", 10.0f, 8.0f, 2.0f, 0, 0.0f, false },
+	{ "fast", 14.0f, 2.5f, 2.0f, 0, 0.0f, false },
+	{ "noisy", 10.0f, 8.0f, 12.0f, 0, 0.0f, false },
+	{ "distract", 10.0f, 8.0f, 2.0f, 3, 0.0f, false },
+	{ "light", 10.0f, 8.0f, 2.0f, 0, 0.5f, false },
+	{ "hard", 14.0f, 4.0f, 8.0f, 3, 0.4f, true }
+};
+
+#define PRESET_COUNT ((int)(sizeof(presets)/sizeof(presets[0])))
+
+// Where the static distractors stand, degrees
+static const float distractorAz[] = { -8.0f, 14.0f, 3.0f };
+static const float distractorEl[] = { 88.0f, 80.0f, 91.0f };
+
+// The target, the static distractors and the crossing one
+#define MAX_OBJECTS (1 + sizeof(distractorAz)/sizeof(distractorAz[0]) + 1)
+
+/*
+ * Constructor, a preset from the list and the seed of its noise
+ */
+Scene::Scene(int preset, unsigned int seed) {
+	this->preset = Math::clamp(preset, 0, PRESET_COUNT-1);
+	random = seed != 0 ? seed : 1;
+	haveSpare = false;
+	spare = 0.0f;
+}
+
+/*
+ * Get the name of a preset, NULL past the end of the list
+ */
+const char* Scene::name(int preset) {
+	return preset >= 0 && preset < PRESET_COUNT ? presets[preset].name : NULL;
+}
+
+/*
+ * Find a preset by name, -1 if there is none
+ */
+int Scene::find(const char* name) {
+	for(int i = 0; i < PRESET_COUNT; i++) {
+		if(strcmp(name, presets[i].name) == 0)
+			return i;
+	}
+	return -1;
+}
+
+/*
+ * Get a uniform random number in [0,1)
+ */
+float Scene::uniform() {
+	// xorshift, the same seed always gives the same scene
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+	return (random >> 8) * (1.0f / (1 << 24));
+}
+
+/*
+ * Get a random number from a normal distribution
+ */
+float Scene::gaussian() {
+	if(haveSpare) {
+		haveSpare = false;
+		return spare;
+	}
+
+	// Box-Muller, two numbers for every pair drawn
+	float u = uniform() + 1e-7f;
+	float v = uniform();
+	float r = sqrtf(-2.0f * logf(u));
+	spare = r * sinf(2.0f * PI * v);
+	haveSpare = true;
+	return r * cosf(2.0f * PI * v);
+}
+
+/*
+ * Get where an object of the preset is at a time, degrees,
+ * returns false if it is hidden
+ */
+bool Scene::place(int object, float t, float* az, float* el) {
+	const Preset* p = &presets[preset];
+
+	// the target loops a figure so both axes keep changing speed
+	if(object == 0) {
+		*az = PATH_AZ + p->amplitude * sinf(2.0f * PI * t / p->period);
+		*el = PATH_EL + 0.6f * p->amplitude * sinf(2.0f * PI * t / (1.37f * p->period));
+		return !p->occlude || fmodf(t, OCCLUDE_PERIOD) < OCCLUDE_PERIOD - OCCLUDE_TIME;
+	}
+
+	if(object <= p->distractors) {
+		*az = distractorAz[object - 1];
+		*el = distractorEl[object - 1];
+		return true;
+	}
+
+	// and one more sweeps across just above the target's path
+	*az = -20.0f + 40.0f * fmodf(t, CROSS_PERIOD) / CROSS_PERIOD;
+	*el = PATH_EL + 2.0f;
+	return true;
+}
+
+/*
+ * Render the view at a time (seconds) with the mount pointing at
+ * pan and tilt (degrees) into FRAME_BYTES laid out as in the VGA
+ * memory, and get where the target is in it, returns false if the
+ * target is hidden or out of view
+ */
+bool Scene::render(float t, float pan, float tilt, unsigned char* frame, float* row, float* col) {
+	const Preset* p = &presets[preset];
+	int objects = 1 + p->distractors + (p->distractors > 0 ? 1 : 0);
+
+	// objects as discs in the image, a hidden one is left out
+	float objRow[MAX_OBJECTS];
+	float objCol[MAX_OBJECTS];
+	float objRadius[MAX_OBJECTS];
+	int objLevel[MAX_OBJECTS];
+	bool shown[MAX_OBJECTS];
+	for(int i = 0; i < objects; i++) {
+		float az, el;
+		shown[i] = place(i, t, &az, &el);
+		objCol[i] = VIEW_COL + SCENE_PAN_PX_PER_DEG * (az - pan);
+		objRow[i] = VIEW_ROW + SCENE_TILT_PX_PER_DEG * (tilt - el);
+		objRadius[i] = i == 0 ? TARGET_RADIUS : (i <= p->distractors ? DISTRACTOR_RADIUS : CROSSER_RADIUS);
+		objLevel[i] = i == 0 ? TARGET_LEVEL : (i <= p->distractors ? DISTRACTOR_LEVEL : CROSSER_LEVEL);
+	}
+
+	// light swells and fades, and falls off toward one side
+	float gain = 1.0f - p->light * (0.5f + 0.5f * sinf(2.0f * PI * t / LIGHT_PERIOD));
+
+	memset(frame, 0, FRAME_BYTES);
+	for(int r = 0; r < VGA_ROWS; r++) {
+		unsigned char* out = frame + (r << VGA_ROW_SHIFT);
+		float el = tilt - (r - VIEW_ROW) / SCENE_TILT_PX_PER_DEG;
+		for(int c = 0; c < VGA_COLUMNS; c++) {
+			float az = pan + (c - VIEW_COL) / SCENE_PAN_PX_PER_DEG;
+
+			// background texture fixed to the world, so it moves with the mount
+			float v = 60.0f + 20.0f * sinf(az * 0.35f) * sinf(el * 0.5f + 1.0f) + 10.0f * sinf(az * 1.1f + el * 0.7f);
+
+			// discs with a one pixel soft edge
+			for(int i = 0; i < objects; i++) {
+				if(!shown[i])
+					continue;
+				float dr = r - objRow[i];
+				float dc = c - objCol[i];
+				float cover = Math::clamp(objRadius[i] + 0.5f - sqrtf(dr*dr + dc*dc), 0.0f, 1.0f);
+				v += (objLevel[i] - v) * cover;
+			}
+
+			v = v * gain * (1.0f - p->light * 0.4f * c / VGA_COLUMNS);
+			v += p->noise * gaussian();
+			out[c] = (unsigned char)Math::clamp(v + 0.5f, 0.0f, 255.0f);
+		}
+	}
+
+	*row = objRow[0];
+	*col = objCol[0];
+	return shown[0] && *row >= 0.0f && *row <= VGA_ROWS-1 && *col >= 0.0f && *col <= VGA_COLUMNS-1;
+}
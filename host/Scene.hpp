@@ -0,0 +1,69 @@
+/*
+ * FILENAME:	Scene.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include "FrameFile.hpp"
+
+// Image shift per degree the mount turns, pixels, close to what
+// CALIBRATE measures and to the default ADJ_PAN/ADJ_TILT
+#define SCENE_PAN_PX_PER_DEG 2.0f
+#define SCENE_TILT_PX_PER_DEG 1.6f
+
+/*
+ * Scene class, renders what the camera would see of a synthetic
+ * world: a target moving along a known path in front of a textured
+ * background, with sensor noise, distractors and changing light
+ * as the preset asks. Positions in the world are in degrees of
+ * pan and tilt, so the view follows the mount.
+ */
+class Scene {
+private:
+	int preset;
+	unsigned int random;
+	bool haveSpare;
+	float spare;
+
+	/*
+	 * Get a uniform random number in [0,1), and one from a
+	 * normal distribution
+	 */
+	float uniform();
+	float gaussian();
+
+	/*
+	 * Get where an object of the preset is at a time, degrees,
+	 * returns false if it is hidden
+	 */
+	bool place(int object, float t, float* az, float* el);
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, a preset from the list and the seed of its noise
+	 */
+	Scene(int preset, unsigned int seed);
+
+	/*
+	 * Get the name of a preset, NULL past the end of the list, and
+	 * find a preset by name, -1 if there is none
+	 */
+	static const char* name(int preset);
+	static int find(const char* name);
+
+	/*
+	 * Render the view at a time (seconds) with the mount pointing at
+	 * pan and tilt (degrees) into FRAME_BYTES laid out as in the VGA
+	 * memory, and get where the target is in it, returns false if the
+	 * target is hidden or out of view
+	 */
+	bool render(float t, float pan, float tilt, unsigned char* frame, float* row, float* col);
+};
+
+#endif /* SCENE_HPP */
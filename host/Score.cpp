@@ -0,0 +1,162 @@
+/*
+ * FILENAME:	Score.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "Score.hpp"
+
+#include <math.h>
+
+// Distance from the truth that counts as on target, pixels
+#define SETTLE_PX 2.0f
+// Frames in a row on target that make a lock
+#define SETTLE_FRAMES 3
+// Distance from the truth that breaks a lock, pixels
+#define LOCK_LOST_PX 8.0f
+// Error counted for a frame the target is missed or falsely found in
+#define MISS_PX 20.0f
+
+/*
+ * Constructor, nothing scored yet
+ */
+Score::Score() {
+	frames = 0;
+	visible = 0;
+	found = 0;
+	lost = 0;
+	falses = 0;
+	errorSum = 0.0;
+	acquisitions = 0;
+	settled = 0;
+	settleSum = 0;
+	lockLosses = 0;
+
+	wasVisible = false;
+	settling = false;
+	locked = false;
+	since = 0;
+	close = 0;
+}
+
+/*
+ * Start timing how long the tracker takes to settle on the target
+ */
+void Score::acquire() {
+	acquisitions++;
+	settling = true;
+	locked = false;
+	since = 0;
+	close = 0;
+}
+
+/*
+ * Score one frame, the truth is only read if the target was
+ * in view
+ */
+void Score::add(bool inView, float row, float col, const FrameReport* report) {
+	frames++;
+
+	if(!inView) {
+		if(report->found)
+			falses++;
+		// the target leaving is not the tracker's fault
+		wasVisible = false;
+		settling = false;
+		locked = false;
+		return;
+	}
+
+	visible++;
+	if(!wasVisible)
+		acquire();
+	wasVisible = true;
+
+	float error = 0.0f;
+	if(report->found) {
+		float dr = report->row - row;
+		float dc = report->col - col;
+		error = sqrtf(dr*dr + dc*dc);
+		errorSum += error;
+		found++;
+	} else {
+		lost++;
+	}
+
+	if(locked && (!report->found || error > LOCK_LOST_PX)) {
+		lockLosses++;
+		acquire();
+	}
+
+	if(settling) {
+		since++;
+		close = (report->found && error <= SETTLE_PX) ? close + 1 : 0;
+		if(close >= SETTLE_FRAMES) {
+			// frames before the run on target began
+			settleSum += since - SETTLE_FRAMES;
+			settled++;
+			settling = false;
+			locked = true;
+		}
+	}
+}
+
+/*
+ * Get the frames scored and those with the target in view
+ */
+unsigned int Score::getFrames() {
+	return frames;
+}
+
+unsigned int Score::getVisible() {
+	return visible;
+}
+
+/*
+ * Get the frames the target was in view but not found, and
+ * found while out of view
+ */
+unsigned int Score::getLost() {
+	return lost;
+}
+
+unsigned int Score::getFalse() {
+	return falses;
+}
+
+/*
+ * Get the mean distance (pixels) from the truth of the target found
+ */
+float Score::meanError() {
+	return found != 0 ? (float)(errorSum / found) : 0.0f;
+}
+
+/*
+ * Get the mean frames taken to settle, and how many
+ * acquisitions never did
+ */
+float Score::meanSettle() {
+	return settled != 0 ? (float)settleSum / settled : 0.0f;
+}
+
+unsigned int Score::getUnsettled() {
+	return acquisitions - settled;
+}
+
+/*
+ * Get how many times a settled lock was lost
+ */
+unsigned int Score::getLockLosses() {
+	return lockLosses;
+}
+
+/*
+ * Get one figure to rank runs by, lower is better: the mean error
+ * with every missed or false frame counted as a large one
+ */
+float Score::cost() {
+	unsigned int counted = visible + falses;
+	if(counted == 0)
+		return 0.0f;
+	return (float)((errorSum + MISS_PX * (lost + falses)) / counted);
+}
@@ -0,0 +1,95 @@
+/*
+ * FILENAME:	Score.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef SCORE_HPP
+#define SCORE_HPP
+
+#include "FrameReport.h"
+
+/*
+ * Score class, grades the tracker frame by frame against where the
+ * target really was. A target is acquired when it comes into view
+ * or after a lock is lost, and settled once it is found close to
+ * the truth for a few frames in a row; a settled lock is lost when
+ * the target is missed or strays while still in view.
+ */
+class Score {
+private:
+	unsigned int frames;
+	unsigned int visible;
+	unsigned int found;
+	unsigned int lost;
+	unsigned int falses;
+	double errorSum;
+	unsigned int acquisitions;
+	unsigned int settled;
+	unsigned int settleSum;
+	unsigned int lockLosses;
+
+	bool wasVisible;
+	bool settling;
+	bool locked;
+	unsigned int since;
+	unsigned int close;
+
+	/*
+	 * Start timing how long the tracker takes to settle on the target
+	 */
+	void acquire();
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, nothing scored yet
+	 */
+	Score();
+
+	/*
+	 * Score one frame, the truth is only read if the target was
+	 * in view
+	 */
+	void add(bool inView, float row, float col, const FrameReport* report);
+
+	/*
+	 * Get the frames scored and those with the target in view
+	 */
+	unsigned int getFrames();
+	unsigned int getVisible();
+
+	/*
+	 * Get the frames the target was in view but not found, and
+	 * found while out of view
+	 */
+	unsigned int getLost();
+	unsigned int getFalse();
+
+	/*
+	 * Get the mean distance (pixels) from the truth of the target found
+	 */
+	float meanError();
+
+	/*
+	 * Get the mean frames taken to settle, and how many
+	 * acquisitions never did
+	 */
+	float meanSettle();
+	unsigned int getUnsettled();
+
+	/*
+	 * Get how many times a settled lock was lost
+	 */
+	unsigned int getLockLosses();
+
+	/*
+	 * Get one figure to rank runs by, lower is better: the mean error
+	 * with every missed or false frame counted as a large one
+	 */
+	float cost();
+};
+
+#endif /* SCORE_HPP */
@@ -0,0 +1,364 @@
+/*
+ * FILENAME:	Sweep.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, tunes the tracker offline. Runs the board's tracker over
+ * a recorded corpus once for every parameter set of a grid (or a random
+ * sample of it) on a work-stealing pool of threads, scores each run
+ * against annotations of where the target really was and ranks the sets.
+ * The best set is printed as console commands.
+ *
+ * Recordings are read as FrameFile.hpp describes. Annotations are CSV
+ * lines of frame,visible,row,col; frames without a line are not scored.
+ * A parameter is fixed with NAME=value or swept with NAME=first:last:step.
+ * Parameters only the control loop reads cannot be swept open loop over
+ * a recording, bench scores those.
+ *
+ * Build: g++ -O2 -std=c++11 -pthread -I.. -o sweep Sweep.cpp WorkPool.cpp
+ *        Score.cpp FrameFile.cpp HostClock.cpp ../Tracker.cpp ../Params.cpp
+ *        ../Pyramid.cpp ../BackgroundModel.cpp ../EdgeFilter.cpp
+ *        ../ColorFilter.cpp ../TemplateTracker.cpp ../Blob.cpp
+ *        ../MultiTracker.cpp ../Overlay.cpp ../Arena.cpp
+ * Usage: sweep frames annotations.csv [-j threads] [-n samples] [-s seed]
+ *        [-t top] [NAME=value|NAME=first:last:step ...]
+ */
+
+#include "FrameFile.hpp"
+#include "WorkPool.hpp"
+#include "Score.hpp"
+#include "Tracker.hpp"
+#include "Params.hpp"
+#include "Pyramid.hpp"
+#include "Overlay.hpp"
+#include "Clock.hpp"
+#include "Arena.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+// Most parameters swept at once
+#define MAX_AXES 8
+// Most parameter sets run
+#define MAX_SETS 1000000
+// Sets listed by default
+#define DEFAULT_TOP 10
+
+// Parameters only the control loop reads. A recording does not move
+// with the mount, so every value of these scores the same here; the
+// closed-loop bench is where they are judged.
+static const char* const controlOnly[] = {
+	"ADJ_PAN", "ADJ_TILT", "PAN_MIN", "PAN_MAX", "TILT_MIN", "TILT_MAX",
+	"SERVO_DEADBAND", "SERVO_DEADTIME"
+};
+
+/*
+ * Axis struct, one parameter swept over evenly spaced values
+ */
+struct Axis {
+	char name[32];
+	float first;
+	float step;
+	int count;
+};
+
+/*
+ * Truth struct, annotation of one frame
+ */
+struct Truth {
+	bool annotated;
+	bool visible;
+	float row;
+	float col;
+};
+
+/*
+ * Result struct, one parameter set and how it scored
+ */
+struct Result {
+	TrackerParams params;
+	float values[MAX_AXES];
+	Score score;
+	float cost;
+	float settle;
+};
+
+static std::vector<unsigned char> frames;
+static std::vector<unsigned char> thresholds;
+static std::vector<Pyramid> pyramids;
+static std::vector<Truth> truth;
+static std::vector<Result> results;
+
+static Axis axes[MAX_AXES];
+static int axisCount = 0;
+
+// frame the tracker works on, segmenting writes into it
+static thread_local unsigned char work[FRAME_BYTES];
+// chroma planes, only read in colour mode
+static unsigned char blank[VGA_ROWS*VGA_COLUMNS];
+
+/*
+ * Read the whole recording and build each frame's pyramid once,
+ * returns the number of frames
+ */
+static int loadFrames(const char* name) {
+	FILE* in = fopen(name, "rb");
+	if(in == NULL) {
+		fprintf(stderr, "ERROR: Cannot open %s\n", name);
+		return 0;
+	}
+
+	unsigned char frame[FRAME_BYTES];
+	unsigned char threshold;
+	while(FrameFile::read(in, frame, &threshold)) {
+		frames.insert(frames.end(), frame, frame + FRAME_BYTES);
+		thresholds.push_back(threshold);
+		pyramids.push_back(Pyramid());
+		pyramids.back().build(frame);
+	}
+	fclose(in);
+	return thresholds.size();
+}
+
+/*
+ * Read the annotations, returns false if the file cannot be read
+ */
+static bool loadTruth(const char* name, int count) {
+	FILE* in = fopen(name, "r");
+	if(in == NULL) {
+		fprintf(stderr, "ERROR: Cannot open %s\n", name);
+		return false;
+	}
+
+	Truth none = { false, false, 0.0f, 0.0f };
+	truth.assign(count, none);
+
+	char line[256];
+	while(fgets(line, sizeof(line), in) != NULL) {
+		int frame, visible;
+		float row, col;
+		// header and comment lines do not parse
+		if(sscanf(line, "%d,%d,%f,%f", &frame, &visible, &row, &col) != 4 || frame < 0 || frame >= count)
+			continue;
+
+		Truth* t = &truth[frame];
+		t->annotated = true;
+		t->visible = visible != 0;
+		t->row = row;
+		t->col = col;
+	}
+	fclose(in);
+	return true;
+}
+
+/*
+ * Take a NAME=value or NAME=first:last:step argument, returns false
+ * if it does not parse or names an unknown parameter
+ */
+static bool parseParam(const char* arg, TrackerParams* base) {
+	const char* eq = strchr(arg, '=');
+	Axis a;
+	if(eq == NULL || eq - arg >= (int)sizeof(a.name))
+		return false;
+	memcpy(a.name, arg, eq - arg);
+	a.name[eq - arg] = '\0';
+
+	float first, last, step;
+	int n = sscanf(eq + 1, "%f:%f:%f", &first, &last, &step);
+	if(n == 1)
+		return Params::set(base, a.name, first);
+
+	if(n != 3 || step <= 0.0f || last < first || axisCount >= MAX_AXES)
+		return false;
+
+	// values are checked as each set is made
+	float current;
+	if(!Params::get(base, a.name, &current))
+		return false;
+
+	for(unsigned int i = 0; i < sizeof(controlOnly)/sizeof(controlOnly[0]); i++) {
+		if(strcmp(a.name, controlOnly[i]) == 0) {
+			fprintf(stderr, "ERROR: %s only acts in closed loop, judge it with bench\n", a.name);
+			return false;
+		}
+	}
+
+	a.first = first;
+	a.step = step;
+	a.count = (int)((last - first) / step + 0.001f) + 1;
+	axes[axisCount++] = a;
+	return true;
+}
+
+/*
+ * Fill a parameter set from its index along each axis, returns false
+ * if the combination is inconsistent
+ */
+static bool makeSet(const int* index, const TrackerParams* base, Result* r) {
+	r->params = *base;
+
+	// setting an axis can clash with another not yet set (a row start
+	// past the old row end), so retry the failures once the rest are in
+	bool ok[MAX_AXES];
+	for(int i = 0; i < axisCount; i++) {
+		r->values[i] = axes[i].first + axes[i].step * (float)index[i];
+		ok[i] = Params::set(&r->params, axes[i].name, r->values[i]);
+	}
+	for(int i = 0; i < axisCount; i++) {
+		if(!ok[i] && !Params::set(&r->params, axes[i].name, r->values[i]))
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Run the tracker with one parameter set over the whole recording
+ */
+static void evaluate(int job, int /*worker*/) {
+	Result* r = &results[job];
+	Overlay overlay;
+	overlay.enable(false);
+	Tracker tracker(&r->params, &overlay);
+	FrameReport report;
+
+	for(unsigned int f = 0; f < thresholds.size(); f++) {
+		memcpy(work, &frames[f * FRAME_BYTES], FRAME_BYTES);
+		Arena::reset();
+		tracker.begin(work, &pyramids[f], blank, blank, thresholds[f], &report);
+		tracker.track(true);
+		overlay.render(work);
+
+		const Truth* t = &truth[f];
+		if(t->annotated)
+			r->score.add(t->visible, t->row, t->col, &report);
+	}
+	r->cost = r->score.cost();
+	r->settle = r->score.meanSettle();
+}
+
+/*
+ * Order results best first: lowest cost, then quickest to settle
+ */
+static bool better(const Result& a, const Result& b) {
+	if(a.cost != b.cost)
+		return a.cost < b.cost;
+	return a.settle < b.settle;
+}
+
+/*
+ * Main function, builds the parameter sets, runs them and ranks them
+ */
+int main(int argc, char** argv) {
+	if(argc < 3) {
+		fprintf(stderr, "Usage: sweep frames annotations.csv [-j threads] [-n samples] [-s seed] "
+				"[-t top] [NAME=value|NAME=first:last:step ...]\n");
+		return 1;
+	}
+
+	int threads = 0;
+	int samples = 0;
+	unsigned int seed = 1;
+	int top = DEFAULT_TOP;
+	TrackerParams base;
+	Params::defaults(&base);
+
+	for(int i = 3; i < argc; i++) {
+		if(argv[i][0] == '-' && argv[i][1] != '\0' && i + 1 < argc && strchr("jnst", argv[i][1]) != NULL && argv[i][2] == '\0') {
+			int value = atoi(argv[++i]);
+			switch(argv[i-1][1]) {
+			case 'j': threads = value; break;
+			case 'n': samples = value; break;
+			case 's': seed = value; break;
+			default: top = value; break;
+			}
+		} else if(!parseParam(argv[i], &base)) {
+			fprintf(stderr, "ERROR: Cannot sweep %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	int count = loadFrames(argv[1]);
+	if(count == 0 || !loadTruth(argv[2], count))
+		return 1;
+
+	// in floating point, a grid of many axes can pass any integer type
+	double gridSize = 1.0;
+	for(int i = 0; i < axisCount; i++)
+		gridSize *= axes[i].count;
+
+	// the whole grid, or a sample of distinct points of it, each point
+	// an index along every axis
+	std::vector<std::vector<int> > points;
+	std::vector<int> index(MAX_AXES, 0);
+	if(samples > 0 && samples < gridSize) {
+		std::mt19937 random(seed);
+		std::set<std::vector<int> > taken;
+		while((int)taken.size() < samples) {
+			for(int i = 0; i < axisCount; i++)
+				index[i] = std::uniform_int_distribution<int>(0, axes[i].count - 1)(random);
+			taken.insert(index);
+		}
+		points.assign(taken.begin(), taken.end());
+	} else if(gridSize <= MAX_SETS) {
+		for(long long p = 0; p < (long long)gridSize; p++) {
+			long long rest = p;
+			for(int i = 0; i < axisCount; i++) {
+				index[i] = rest % axes[i].count;
+				rest /= axes[i].count;
+			}
+			points.push_back(index);
+		}
+	} else {
+		fprintf(stderr, "ERROR: Grid of %.0f sets is too large, sample it with -n\n", gridSize);
+		return 1;
+	}
+
+	Result r;
+	for(unsigned int i = 0; i < points.size(); i++) {
+		if(makeSet(&points[i][0], &base, &r))
+			results.push_back(r);
+	}
+	if(results.empty()) {
+		fprintf(stderr, "ERROR: No consistent parameter set to run\n");
+		return 1;
+	}
+
+	Clock::init();
+	WorkPool pool(threads);
+	for(unsigned int i = 0; i < results.size(); i++)
+		pool.add(i);
+
+	unsigned int start = Clock::now();
+	pool.run(evaluate);
+	float seconds = Clock::toMicros(Clock::now() - start) / 1000000.0f;
+
+	std::sort(results.begin(), results.end(), better);
+
+	fprintf(stderr, "%u sets over %d frames on %d threads in %.1f s, %.0f frames/s\n",
+			(unsigned int)results.size(), count, pool.size(), seconds,
+			seconds > 0.0f ? results.size() * count / seconds : 0.0f);
+
+	printf("rank,cost,error_px,lost,false,settle_frames,unsettled,lock_losses");
+	for(int i = 0; i < axisCount; i++)
+		printf(",%s", axes[i].name);
+	printf("\n");
+
+	for(int k = 0; k < top && k < (int)results.size(); k++) {
+		Result* res = &results[k];
+		Score* s = &res->score;
+		printf("%d,%.3f,%.3f,%u,%u,%.2f,%u,%u", k + 1, res->cost, s->meanError(), s->getLost(),
+				s->getFalse(), s->meanSettle(), s->getUnsettled(), s->getLockLosses());
+		for(int i = 0; i < axisCount; i++)
+			printf(",%g", res->values[i]);
+		printf("\n");
+	}
+
+	printf("\n");
+	Params::print(&results[0].params);
+	return 0;
+}
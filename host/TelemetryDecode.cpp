@@ -0,0 +1,98 @@
+/*
+ * FILENAME:	TelemetryDecode.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Host tool, converts a capture of the JTAG UART stream (for example
+ * nios2-terminal > capture.bin) into CSV, one line per telemetry record.
+ * Console text mixed into the stream is skipped.
+ *
+ * Build: g++ -O2 -I.. -o telemetry_decode TelemetryDecode.cpp
+ * Usage: telemetry_decode [capture.bin] > telemetry.csv
+ */
+
+#include "TelemetryRecord.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// CPU clock ticks per microsecond on the board
+#define TICKS_PER_US 50
+
+/*
+ * Check the checksum of a candidate record
+ */
+static bool valid(const unsigned char* bytes) {
+	TelemetryRecord rec;
+	memcpy(&rec, bytes, sizeof(rec));
+
+	unsigned short sum = 0;
+	for(unsigned int i = 0; i < sizeof(rec) - sizeof(rec.checksum); i++)
+		sum += bytes[i];
+
+	return rec.sync == TELEM_SYNC && rec.checksum == sum;
+}
+
+/*
+ * Print a coordinate, empty if there is none
+ */
+static void coord(unsigned char v) {
+	if(v == TELEM_NONE)
+		printf(",");
+	else
+		printf(",%d", v);
+}
+
+/*
+ * Main function, scans the stream for records and prints them
+ */
+int main(int argc, char** argv) {
+	FILE* in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+	if(in == NULL) {
+		fprintf(stderr, "ERROR: Cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	unsigned char window[sizeof(TelemetryRecord)];
+	unsigned int fill = 0;
+	unsigned int records = 0;
+	unsigned int lost = 0;
+	int lastSeq = -1;
+	int ch;
+
+	printf("seq,time_us,threshold,found,segment,tracker,row,col,ulr,ulc,lrr,lrc,pan_deg,tilt_deg,capture_us,analysis_us,control_us\n");
+
+	while((ch = fgetc(in)) != EOF) {
+		window[fill++] = ch;
+		if(fill < sizeof(window))
+			continue;
+
+		// not a record here, slide one byte and keep looking
+		if(!valid(window)) {
+			memmove(window, window + 1, --fill);
+			continue;
+		}
+		fill = 0;
+
+		TelemetryRecord rec;
+		memcpy(&rec, window, sizeof(rec));
+
+		if(lastSeq >= 0)
+			lost += (unsigned short)(rec.seq - lastSeq - 1);
+		lastSeq = rec.seq;
+		records++;
+
+		printf("%u,%u,%u,%d,%d,%d", rec.seq, rec.timestamp / TICKS_PER_US, rec.threshold,
+				(rec.flags & TELEM_FOUND) != 0, (rec.flags >> TELEM_SEGMENT_SHIFT) & 3, (rec.flags >> TELEM_TRACKER_SHIFT) & 3);
+		coord(rec.row);
+		coord(rec.col);
+		coord(rec.ulr);
+		coord(rec.ulc);
+		coord(rec.lrr);
+		coord(rec.lrc);
+		printf(",%.2f,%.2f,%u,%u,%u\n", rec.pan / 100.0f, rec.tilt / 100.0f, rec.capture, rec.analysis, rec.control);
+	}
+
+	fprintf(stderr, "%u records, %u lost\n", records, lost);
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * FILENAME:	WorkPool.cpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#include "WorkPool.hpp"
+
+#include <thread>
+#include <vector>
+
+/*
+ * Constructor, pool of a number of workers, every core if zero
+ */
+WorkPool::WorkPool(int workers) {
+	if(workers <= 0)
+		workers = std::thread::hardware_concurrency();
+	this->workers = workers > 0 ? workers : 1;
+	queues = new Queue[this->workers];
+	next = 0;
+}
+
+/*
+ * Destructor, frees the queues
+ */
+WorkPool::~WorkPool() {
+	delete[] queues;
+}
+
+/*
+ * Get the number of workers
+ */
+int WorkPool::size() {
+	return workers;
+}
+
+/*
+ * Queue a job, jobs are dealt to the workers in turn
+ */
+void WorkPool::add(int job) {
+	Queue* q = &queues[next];
+	next = (next + 1) % workers;
+
+	std::lock_guard<std::mutex> hold(q->lock);
+	q->jobs.push_back(job);
+}
+
+/*
+ * Get a job for a worker, its own newest or another's oldest,
+ * returns false once every queue is empty
+ */
+bool WorkPool::take(int worker, int* job) {
+	{
+		Queue* own = &queues[worker];
+		std::lock_guard<std::mutex> hold(own->lock);
+		if(!own->jobs.empty()) {
+			*job = own->jobs.back();
+			own->jobs.pop_back();
+			return true;
+		}
+	}
+
+	// jobs are only added before the pool runs, so an empty
+	// sweep of every queue means the work is done
+	for(int i = 1; i < workers; i++) {
+		Queue* victim = &queues[(worker + i) % workers];
+		std::lock_guard<std::mutex> hold(victim->lock);
+		if(!victim->jobs.empty()) {
+			*job = victim->jobs.front();
+			victim->jobs.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Run jobs on one worker until there are none left anywhere
+ */
+void WorkPool::work(int worker, void (*run)(int job, int worker)) {
+	int job;
+	while(take(worker, &job))
+		run(job, worker);
+}
+
+/*
+ * Run every queued job and wait for them all to finish, jobs
+ * may run in any order and on any worker
+ */
+void WorkPool::run(void (*run)(int job, int worker)) {
+	std::vector<std::thread> threads;
+	for(int i = 1; i < workers; i++)
+		threads.push_back(std::thread(&WorkPool::work, this, i, run));
+
+	// this thread is the first worker
+	work(0, run);
+	for(unsigned int i = 0; i < threads.size(); i++)
+		threads[i].join();
+}
@@ -0,0 +1,75 @@
+/*
+ * FILENAME:	WorkPool.hpp
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ */
+
+#ifndef WORKPOOL_HPP
+#define WORKPOOL_HPP
+
+#include <deque>
+#include <mutex>
+
+/*
+ * WorkPool class, runs numbered jobs on a set of worker threads. Each
+ * worker has its own queue and works from its back; a worker whose
+ * queue runs dry steals from the front of the others, so long jobs
+ * landing on one worker do not leave the rest idle.
+ */
+class WorkPool {
+private:
+	/*
+	 * Queue struct, jobs waiting for one worker
+	 */
+	struct Queue {
+		std::mutex lock;
+		std::deque<int> jobs;
+	};
+
+	Queue* queues;
+	int workers;
+	int next;
+
+	/*
+	 * Get a job for a worker, its own newest or another's oldest,
+	 * returns false once every queue is empty
+	 */
+	bool take(int worker, int* job);
+
+	/*
+	 * Run jobs on one worker until there are none left anywhere
+	 */
+	void work(int worker, void (*run)(int job, int worker));
+
+protected:
+
+public:
+
+	/*
+	 * Constructor, pool of a number of workers, every core if zero
+	 */
+	WorkPool(int workers);
+
+	/*
+	 * Destructor, frees the queues
+	 */
+	~WorkPool();
+
+	/*
+	 * Get the number of workers
+	 */
+	int size();
+
+	/*
+	 * Queue a job, jobs are dealt to the workers in turn
+	 */
+	void add(int job);
+
+	/*
+	 * Run every queued job and wait for them all to finish, jobs
+	 * may run in any order and on any worker
+	 */
+	void run(void (*run)(int job, int worker));
+};
+
+#endif /* WORKPOOL_HPP */
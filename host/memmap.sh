@@ -0,0 +1,68 @@
+#!/bin/sh
+#
+# FILENAME:	memmap.sh
+# AUTHOR:	Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+# DATE:		October 19, 2026
+#
+# Build-time memory map of the board image: section sizes and where
+# they were linked, the objects placed on chip by onchip.x, the largest
+# statically allocated objects, and a check that nothing pulls
+# operator new or malloc into the image.
+#
+# Usage: memmap.sh <app.elf> [count]
+#
+
+ELF=$1
+COUNT=${2:-20}
+CROSS=${CROSS-nios2-elf-}
+
+if [ -z "$ELF" ] || [ ! -f "$ELF" ]; then
+	echo "Usage: $0 <app.elf> [count]" >&2
+	exit 1
+fi
+
+echo "== Sections"
+${CROSS}size -A -x "$ELF" | awk 'NR > 2 && $2 != "0x0" && NF == 3'
+
+echo
+echo "== On chip after the VGA frame (size, address, name)"
+# 8396288-8396800 is 0x801E00-0x802000, awk has no hex literals
+${CROSS}nm -C -S -n "$ELF" | awk '
+	function hex(h,   v, i) {
+		v = 0
+		for(i = 1; i <= length(h); i++)
+			v = v * 16 + index("0123456789abcdef", tolower(substr(h, i, 1))) - 1
+		return v
+	}
+	$1 ~ /^[0-9a-fA-F]+$/ && NF >= 4 {
+		a = hex($1)
+		if(a >= 8396288 && a < 8396800) {
+			s = hex($2)
+			n = $4; for(i = 5; i <= NF; i++) n = n " " $i
+			printf("%6d  0x%s  %s\n", s, $1, n)
+			if(a + s > end) end = a + s
+		}
+	}
+	END {
+		used = end > 0 ? end - 8396288 : 0
+		printf("%d of 512 bytes used\n", used)
+	}'
+
+echo
+echo "== Largest objects (size, address, name)"
+${CROSS}nm -C -S --size-sort -r "$ELF" | awk '$3 ~ /^[bBdDrR]$/' | head -n "$COUNT" |
+	while read addr size type name; do
+		printf "%6d  0x%s  %s\n" "0x$size" "$addr" "$name"
+	done
+
+echo
+echo "== Heap"
+HEAP=$(${CROSS}nm "$ELF" | awk '$3 ~ /^(_Znwj|_Znaj|_ZdlPv|_ZdaPv)$/ { print $3 }')
+if [ -n "$HEAP" ]; then
+	echo "operator new/delete linked: $HEAP"
+else
+	echo "operator new/delete not linked"
+fi
+if ${CROSS}nm "$ELF" | awk '$3 == "malloc" { found = 1 } END { exit !found }'; then
+	echo "malloc linked (newlib stdio buffers use it once at startup)"
+fi
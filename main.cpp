@@ -14,217 +14,434 @@
 // A few simple math functions
 #include "Math.hpp"
 
+// Non-blocking line input and command table dispatch
+#include "Console.hpp"
+
+// Scratch space shared by the stages of a frame
+#include "Arena.hpp"
+
+// Timestamps and the binary streams sharing the debug link
+#include "Clock.hpp"
+#include "Scheduler.hpp"
+#include "Link.hpp"
+#include "Telemetry.hpp"
+#include "Preview.hpp"
+
 // A CameraMount object, which controls servos,
 // I2C camera communication, and camera image data
 #include "CameraMount.hpp"
 
-// Input constants
-#define BUFFER_SIZE 80
-#define MAX_ARGS 20
-#define MAX_ARG_LENGTH 20
+// What the main loop does between commands
+typedef enum {
+	RUN_IDLE,
+	RUN_TRACK,
+	RUN_CAMFEED
+} RunState;
 
-// Used to determine the parsed type of data input
+// Where the current frame is in the tracking pipeline
 typedef enum {
-	SUCCESS_INTEGER=3,
-	SUCCESS_FLOAT=2,
-	SUCCESS_STRING=1,
-	SUCCESS_NONE=0
-} SuccessType;
+	STAGE_CAPTURE,
+	STAGE_ANALYZE,
+	STAGE_CONTROL,
+	STAGE_PUBLISH
+} FrameStage;
+
+// Every subsystem is allocated statically, the debug link is shared
+// by the binary streams so it is constructed before them
+static CameraMount cm;
+static Link link;
+static Telemetry telemetry(&link);
+static Preview preview(&link);
+static RunState state = RUN_IDLE;
+static FrameStage stage = STAGE_CAPTURE;
+
+// Keywords accepted by the mode selection commands, in enum order
+static const char* const segmentKeys[] = { "BRIGHT", "MOTION", "EDGE", "COLOR", NULL };
+static const char* const trackerKeys[] = { "RUNS", "TEMPLATE", "MULTI", NULL };
+static const char* const policyKeys[] = { "LARGEST", "OLDEST", "CENTER", NULL };
+static const char* const onOffKeys[] = { "OFF", "ON", NULL };
+static const char* const previewKeys[] = { "OFF", "FRAME", "MASK", NULL };
+
+// Why a capture was abandoned, by FrameStatus
+static const char* const frameStatusNames[] = {
+	"OK", "no VSYNC", "no HREF", "no PCLK", "short line", "long line", "short frame"
+};
+
+// Control exposure and gain from the frames, or leave them to the sensor
+static void cmdAec(const Arg* args) {
+	cm.setAutoExposure(args[0].i != 0);
+	cm.printExposure();
+}
+
+// Fit the servo gains to the target in view
+static void cmdCalibrate(const Arg* args) {
+	printf("Calibrating, keep the target still in view\n");
+	cm.calibrate();
+}
+
+// Start a continuous feed of camera data
+static void cmdCamfeed(const Arg* args) {
+	cm.clearOverlay();
+	state = RUN_CAMFEED;
+	stage = STAGE_CAPTURE;
+}
+
+// Pick the fastest camera clock every edge is captured at
+static void cmdClock(const Arg* args) {
+	cm.testClock();
+}
+
+// Copy a range of memory to another address
+static void cmdCopy(const Arg* args) {
+	Memory::copy(args[0].i, args[1].i, args[2].i);
+	printf("Memory copied: 0x%08X-0x%08X to 0x%08X\n\n", args[0].i, args[1].i, args[2].i);
+}
+
+// Read from a camera subaddress
+static void cmdCR(const Arg* args) {
+	printf("Cam register %X: %X\n", args[0].i, cm.read(args[0].i));
+}
+
+// Write a byte to a camera subaddress
+static void cmdCW(const Arg* args) {
+	cm.write(args[0].i, args[1].i);
+	printf("Cam register %X: %X\n", args[0].i, args[1].i);
+}
+
+// Set a range of memory to one byte value
+static void cmdFill(const Arg* args) {
+	Memory::fill(args[0].i, args[1].i, args[2].i);
+	printf("Memory filled: %02X @ 0x%08X-0x%08X\n\n", args[2].i & 0xFF, args[0].i, args[1].i);
+}
+
+// Print command information, defined with the console below
+static void cmdHelp(const Arg* args);
+
+// Show where the subsystems live and how much scratch space is used
+static void cmdMap(const Arg* args) {
+	printf("CameraMount: %5u bytes @ 0x%08X\n", sizeof(cm), (unsigned int)&cm);
+	printf("Telemetry:   %5u bytes @ 0x%08X\n", sizeof(telemetry), (unsigned int)&telemetry);
+	printf("Preview:     %5u bytes @ 0x%08X\n", sizeof(preview), (unsigned int)&preview);
+	printf("Arena:       %5u bytes, %u used, %u peak\n\n", ARENA_SIZE, Arena::used(), Arena::peak());
+}
+
+// Choose what the tracker segments the frame by
+static void cmdMode(const Arg* args) {
+	printf("Segmenting by %s\n", segmentKeys[args[0].i]);
+	cm.setSegmentMode((SegmentMode)args[0].i);
+}
+
+// Turn the tracking annotations on the display on or off
+static void cmdOverlay(const Arg* args) {
+	cm.setOverlay(args[0].i != 0);
+	printf("Overlay %s\n", onOffKeys[args[0].i]);
+}
+
+// Change pan servo position
+static void cmdPan(const Arg* args) {
+	printf("Pan camera: %f\n", args[0].f);
+	cm.pan(args[0].f);
+}
+
+// Choose which target drives the servos
+static void cmdPolicy(const Arg* args) {
+	printf("Following %s target\n", policyKeys[args[0].i]);
+	cm.setSelectPolicy((SelectPolicy)args[0].i);
+}
+
+// Print every tracker parameter
+static void cmdParams(const Arg* args) {
+	cm.printParams();
+}
+
+// Read one tracker parameter
+static void cmdGet(const Arg* args) {
+	float value;
+	if(cm.getParam(args[0].s, &value))
+		printf("%s = %f\n", args[0].s, value);
+	else
+		printf("ERROR: Unknown parameter\n");
+}
+
+// Change one tracker parameter, takes effect on the next frame
+static void cmdSet(const Arg* args) {
+	if(cm.setParam(args[0].s, args[1].f))
+		printf("%s = %f\n", args[0].s, args[1].f);
+	else
+		printf("ERROR: Unknown parameter or value out of range\n");
+}
+
+// Keep the current parameters across RESET
+static void cmdSave(const Arg* args) {
+	cm.saveParams();
+}
+
+// Choose what the compressed live preview streams
+static void cmdPreview(const Arg* args) {
+	preview.setMode((PreviewMode)args[0].i);
+	printf("Preview %s\n", previewKeys[args[0].i]);
+}
+
+// Read a range of memory and output results to console
+static void cmdRD(const Arg* args) {
+	Memory::dump(args[0].i, args[1].i, false);
+}
+
+// Send a range of memory to the console as raw bytes
+static void cmdRDRaw(const Arg* args) {
+	Memory::dump(args[0].i, args[1].i, true);
+}
+
+// Reset CameraMount
+static void cmdReset(const Arg* args) {
+	printf("Resetting...\n");
+	cm.reset();
+}
+
+// Take one image and display it to the VGA
+static void cmdSnapshot(const Arg* args) {
+	printf("Taking a snapshot\n");
+	FrameStatus status = cm.getCameraFrame(false);
+	if(status != FRAME_OK)
+		printf("Frame abandoned: %s\n", frameStatusNames[status]);
+}
+
+// Return to waiting for commands
+static void cmdStop(const Arg* args) {
+	printf("Stopped\n");
+	cm.clearOverlay();
+	state = RUN_IDLE;
+}
+
+// List the targets being followed
+static void cmdTargets(const Arg* args) {
+	cm.printTargets();
+}
+
+// Print how long each task has been taking
+static void cmdTasks(const Arg* args) {
+	Scheduler::print();
+}
+
+// Start or stop the binary telemetry stream
+static void cmdTelem(const Arg* args) {
+	telemetry.enable(args[0].i != 0);
+	printf("Telemetry %s, %u records dropped\n", onOffKeys[args[0].i], telemetry.getDropped());
+}
+
+// Take one frame and show the thresholded region of interest
+static void cmdTest(const Arg* args) {
+	FrameStatus status = cm.getCameraFrame(false);
+	if(status != FRAME_OK) {
+		printf("Frame abandoned: %s\n", frameStatusNames[status]);
+		return;
+	}
+	cm.updateThreshold();
+	cm.adjustServos();
+	cm.control();
+	cm.testFrame();
+	cm.drawOverlay();
+}
+
+// Change tilt servo position
+static void cmdTilt(const Arg* args) {
+	printf("Tilt camera: %f\n", args[0].f);
+	cm.tilt(args[0].f);
+}
+
+// Start camera tracking
+static void cmdTrack(const Arg* args) {
+	cm.clearOverlay();
+	state = RUN_TRACK;
+	stage = STAGE_CAPTURE;
+}
+
+// Choose how the target is followed between frames
+static void cmdTracker(const Arg* args) {
+	printf("Tracking with %s\n", trackerKeys[args[0].i]);
+	cm.setTrackerMode((TrackerMode)args[0].i);
+}
+
+// Check a chroma range fits a byte and is not inverted
+static bool checkBox(const Arg* args) {
+	if(args[0].i < 0 || args[1].i > 255 || args[0].i > args[1].i) {
+		printf("ERROR: Range must be within 0-255 with min <= max\n");
+		return false;
+	}
+	return true;
+}
+
+// Set the chroma ranges followed in colour mode
+static void cmdUBox(const Arg* args) {
+	if(!checkBox(args))
+		return;
+	cm.setColorBox(false, args[0].i, args[1].i);
+	printf("U range: %d-%d\n", args[0].i, args[1].i);
+}
+
+static void cmdVBox(const Arg* args) {
+	if(!checkBox(args))
+		return;
+	cm.setColorBox(true, args[0].i, args[1].i);
+	printf("V range: %d-%d\n", args[0].i, args[1].i);
+}
+
+// Write a byte value to a memory address
+static void cmdWR(const Arg* args) {
+	Memory::write(args[0].i, args[1].i);
+	printf("Memory written: %02X @ 0x%08X\n\n", args[1].i, args[0].i);
+}
+
+// Command table, must stay sorted by name for the binary search
+static const Command commands[] = {
+	{ "AEC", "k", onOffKeys, cmdAec, "AEC ON|OFF", "Control exposure and gain from each frame, or leave them to the sensor" },
+	{ "CALIBRATE", "", NULL, cmdCalibrate, "CALIBRATE", "Step the servos and fit ADJ_PAN, ADJ_TILT and SERVO_DEADTIME to the target in view" },
+	{ "CAMFEED", "", NULL, cmdCamfeed, "CAMFEED", "Start a continuous camera feed (STOP to end)" },
+	{ "CLOCK", "", NULL, cmdClock, "CLOCK", "Find the fastest camera clock every pixel is captured at and report the frame rate" },
+	{ "COPY", "iii", NULL, cmdCopy, "COPY addr1 addr2 dest", "Copy a range of bytes in memory to another address" },
+	{ "CR", "i", NULL, cmdCR, "CR subaddr", "Read from a camera subaddress" },
+	{ "CW", "ii", NULL, cmdCW, "CW subaddr value", "Write to a camera subaddress" },
+	{ "FILL", "iii", NULL, cmdFill, "FILL addr1 addr2 value", "Set a range of bytes in memory to one value" },
+	{ "GET", "s", NULL, cmdGet, "GET name", "Show a tracker parameter" },
+	{ "HELP", "", NULL, cmdHelp, "HELP", "Show these commands" },
+	{ "MAP", "", NULL, cmdMap, "MAP", "Show subsystem addresses and scratch arena use" },
+	{ "MODE", "k", segmentKeys, cmdMode, "MODE BRIGHT|MOTION|EDGE|COLOR", "Track the brightest, moving, most edged or coloured object" },
+	{ "OVERLAY", "k", onOffKeys, cmdOverlay, "OVERLAY ON|OFF", "Draw the target box, crosshair, threshold and frame rate over the display" },
+	{ "PAN", "f", NULL, cmdPan, "PAN deg", "Pan the camera to a certain position (degrees)" },
+	{ "PARAMS", "", NULL, cmdParams, "PARAMS", "Show every tracker parameter" },
+	{ "POLICY", "k", policyKeys, cmdPolicy, "POLICY LARGEST|OLDEST|CENTER", "Choose which target drives the servos in MULTI" },
+	{ "PREVIEW", "k", previewKeys, cmdPreview, "PREVIEW OFF|FRAME|MASK", "Stream the frame or its mask, compressed, on the debug link" },
+	{ "RD", "ii", NULL, cmdRD, "RD addr1 addr2", "Read a range of bytes in memory to console" },
+	{ "RDRAW", "ii", NULL, cmdRDRaw, "RDRAW addr1 addr2", "Send a range of bytes in memory to console unformatted" },
+	{ "RESET", "", NULL, cmdReset, "RESET", "Reset the camera" },
+	{ "SAVE", "", NULL, cmdSave, "SAVE", "Keep the tracker parameters across RESET and print them" },
+	{ "SET", "sf", NULL, cmdSet, "SET name value", "Change a tracker parameter, also while tracking" },
+	{ "SNAPSHOT", "", NULL, cmdSnapshot, "SNAPSHOT", "Get a new frame from the camera" },
+	{ "STOP", "", NULL, cmdStop, "STOP", "End TRACK or CAMFEED" },
+	{ "TARGETS", "", NULL, cmdTargets, "TARGETS", "List the targets being followed" },
+	{ "TASKS", "", NULL, cmdTasks, "TASKS", "Show how long each task of the main loop takes against its budget" },
+	{ "TELEM", "k", onOffKeys, cmdTelem, "TELEM ON|OFF", "Stream a binary record of every tracked frame" },
+	{ "TEST", "", NULL, cmdTest, "TEST", "Get a frame and show the thresholded region of interest" },
+	{ "TILT", "f", NULL, cmdTilt, "TILT deg", "Tilt the camera to a certain position (degrees)" },
+	{ "TRACK", "", NULL, cmdTrack, "TRACK", "Start camera tracking (STOP to end)" },
+	{ "TRACKER", "k", trackerKeys, cmdTracker, "TRACKER RUNS|TEMPLATE|MULTI", "Follow the longest runs, a reference patch or every target" },
+	{ "UBOX", "ii", NULL, cmdUBox, "UBOX min max", "Set the U range followed by MODE COLOR" },
+	{ "VBOX", "ii", NULL, cmdVBox, "VBOX min max", "Set the V range followed by MODE COLOR" },
+	{ "WR", "ii", NULL, cmdWR, "WR addr value", "Write a byte to memory" }
+};
+
+static Console console(commands, sizeof(commands)/sizeof(commands[0]));
+
+// Print command information
+static void cmdHelp(const Arg* args) {
+	console.help();
+}
+
+// Capture is due once the time left before the next VSYNC is the
+// margin, until then that time is held for the tasks below
+static bool captureReady() {
+	if(state == RUN_IDLE || stage != STAGE_CAPTURE)
+		return false;
+
+	unsigned int due = cm.frameDue();
+	Scheduler::hold(due);
+	return (int)(Clock::now() - due) >= 0;
+}
+
+// Read a frame, a bad frame is dropped rather than steering the servos
+static void captureRun() {
+	if(cm.getCameraFrame(false) != FRAME_OK)
+		return;
+	stage = state == RUN_TRACK ? STAGE_ANALYZE : STAGE_PUBLISH;
+}
+
+static bool analyzeReady() {
+	return stage == STAGE_ANALYZE;
+}
+
+// Locate the target in the frame
+static void analyzeRun() {
+	cm.track();
+	stage = STAGE_CONTROL;
+}
+
+static bool controlReady() {
+	return stage == STAGE_CONTROL;
+}
+
+// Move the servos toward the target and record what was done
+static void controlRun() {
+	cm.control();
+	telemetry.record(cm.getReport());
+	stage = STAGE_PUBLISH;
+}
+
+static bool publishReady() {
+	return stage == STAGE_PUBLISH;
+}
+
+// Hand the frame to the preview, then draw the overlay over it
+static void publishRun() {
+	preview.offer(cm.getCameraFrameData(), cm.getThreshold());
+	cm.drawOverlay();
+	stage = STAGE_CAPTURE;
+}
+
+static bool sensorReady() {
+	return cm.sensorPending();
+}
+
+// Write the exposure and gain over I2C
+static void sensorRun() {
+	cm.serviceSensor();
+}
+
+static bool alwaysReady() {
+	return true;
+}
+
+// Read input, run a command once a line is complete
+static void consoleRun() {
+	if(console.poll())
+		console.execute();
+}
+
+// Send whatever telemetry and preview the link has room for
+static void telemetryRun() {
+	telemetry.drain();
+}
+
+static void previewRun() {
+	preview.drain();
+}
+
+// Every activity of the main loop, highest priority first. The frame
+// pipeline runs straight through once a capture completes, services
+// fill the rest of the frame and never start a run whose budget
+// would make capture miss its VSYNC.
+static Task tasks[] = {
+	{ "CAPTURE", captureReady, captureRun, 50000, 0, 0, 0 },
+	{ "ANALYZE", analyzeReady, analyzeRun, 20000, 0, 0, 0 },
+	{ "CONTROL", controlReady, controlRun, 500, 0, 0, 0 },
+	{ "PUBLISH", publishReady, publishRun, 5000, 0, 0, 0 },
+	{ "SENSOR", sensorReady, sensorRun, 1000, 0, 0, 0 },
+	{ "CONSOLE", alwaysReady, consoleRun, 1000, 0, 0, 0 },
+	{ "TELEMETRY", alwaysReady, telemetryRun, 500, 0, 0, 0 },
+	{ "PREVIEW", alwaysReady, previewRun, 1000, 0, 0, 0 }
+};
 
 /*
- * Main function, requests user input and executes appropriate command
+ * Main function, starts the sensor and hands over to the scheduler
  */
 int main() {
 
 	// initialization
-	char* rxbuffer = new char[BUFFER_SIZE];
-	char* cmd = new char[MAX_ARG_LENGTH];
-	char* sargs[MAX_ARGS];
-	int* iargs[MAX_ARGS];
-	float* fargs[MAX_ARGS];
-	SuccessType successes[MAX_ARGS];
-
-	for(int i=0; i < MAX_ARGS; i++){
-		sargs[i] = new char[MAX_ARG_LENGTH];
-		iargs[i] = new int;
-		fargs[i] = new float;
-		successes[i] = SUCCESS_NONE;
-	}
-
-	CameraMount* cm = new CameraMount();
+	Clock::init();
+	cm.testClock();
 
 	printf("Enter \"HELP\" for a list of commands.\n\n");
 
-	while(true) {
-		// Retrieve input into rxbuffer
-		fgets(rxbuffer, BUFFER_SIZE, stdin);
-
-		// decode input into strings
-		int fields = sscanf(rxbuffer, "%s%s%s", cmd, sargs[0], sargs[1]);
-		bool success = (fields != 0);
-
-
-
-		// decode arguments into numerical values if possible
-		for(int n=0;fields >= n+2; n++) {
-			successes[n] = SUCCESS_NONE;
-			if(sargs[n][0] != '\0')
-				successes[n] = SUCCESS_STRING;
-			if(sscanf(sargs[n], "%f", fargs[n]) == 1)
-				successes[n] = SUCCESS_FLOAT;
-			if(sscanf(sargs[n], "%i", iargs[n]) == 1)
-				successes[n] = SUCCESS_INTEGER;
-		}
-
-		// perform input command
-		if(success) {
-			switch(fields) {
-			case 3:
-				// Read a range of memory and output results to console
-				if(strcmp(cmd, "RD") == 0 && successes[0] >= SUCCESS_INTEGER && successes[1] >= SUCCESS_INTEGER) {
-					char* read = Memory::readRange(*iargs[0], *iargs[1]);
-
-					printf("Memory Read:");
-					for(int i=0; i<= (*iargs[1]-*iargs[0]); i++) {
-						if((i % 16) == 0)
-							printf("\n0x%08X: ", *iargs[0] + i);
-
-							printf("%02X ", (char)read[i]);
-					}
-					printf("\n");
-
-					delete read;
-
-				// Write a byte value to a memory address
-				} else if(strcmp(cmd, "WR") == 0 && successes[0] >= SUCCESS_INTEGER && successes[1] >= SUCCESS_INTEGER) {
-					Memory::write(*iargs[0], *iargs[1]);
-					printf("Memory written: %02X @ 0x%08X\n\n", *iargs[1], *iargs[0]);
-
-				// Write a byte to a camera subaddress
-				} else if(strcmp(cmd, "CW") == 0 && successes[0] >= SUCCESS_INTEGER && successes[1] >= SUCCESS_INTEGER) {
-					cm->write(*iargs[0], *iargs[1]);
-					printf("Cam register %X: %X", *iargs[0], *iargs[1]);
-
-				// Invalid input
-				} else {
-					printf("ERROR: Invalid command\n");
-				}
-				break;
-			case 2:
-				// Change pan servo position
-				if(strcmp(cmd, "PAN") == 0 && successes[0] >= SUCCESS_FLOAT) {
-					printf("Pan camera: %f\n", *fargs[0]);
-					cm->pan(*fargs[0]);
-
-				// Change tilt servo position
-				} else if(strcmp(cmd, "TILT") == 0 && successes[0] >= SUCCESS_FLOAT) {
-					printf("Tilt camera: %f\n", *fargs[0]);
-					cm->tilt(*fargs[0]);
-
-				// Read from a camera subaddress
-				} else if(strcmp(cmd, "CR") == 0 && successes[0] >= SUCCESS_INTEGER) {
-					printf("Cam register %X: %X", *iargs[0], cm->read(*iargs[0]));
-
-				// Invalid input
-				} else {
-					printf("ERROR: Invalid command\n");
-				}
-				break;
-			case 1:
-				// Reset CameraMount
-				if(strcmp(cmd, "RESET") == 0) {
-					printf("Resetting...\n");
-					cm->reset();
-
-				} else if(strcmp(cmd, "TEST") == 0) {
-					cm->getCameraFrame(false);
-					cm->updateThreshold();
-					cm->testFrame();
-					cm->adjustServos();
-
-				// Take one image and display it to the VGA
-				} else if (strcmp(cmd, "SNAPSHOT") == 0) {
-					printf("Taking a snapshot\n");
-					cm->getCameraFrame(false);
-
-				// Same as SNAPSHOT, but also print debug info
-				} else if (strcmp(cmd, "TRACK") == 0) {
-					while(true) {
-						cm->getCameraFrame(false);
-						cm->updateThreshold();
-						cm->adjustServos();
-					}
-				// Start a continuous feed of camera data
-				} else if (strcmp(cmd, "CAMFEED") == 0) {
-					while(true) cm->getCameraFrame(false);
-
-				// Print command information
-				} else if (strcmp(cmd, "HELP") == 0) {
-					printf("Commands:\n");
-
-					printf("RD addr1 addr2\n");
-					printf("  Read a range of bytes in memory to console\n");
-					printf("\n");
-
-					printf("WR addr value\n");
-					printf("  Write a byte to memory\n");
-					printf("\n");
-
-					printf("CW subaddr value\n");
-					printf("  Write to a camera subaddress\n");
-					printf("\n");
-
-					printf("PAN deg\n");
-					printf("  Pan the camera to a certain position (degrees)\n");
-					printf("\n");
-
-					printf("TILT deg\n");
-					printf(" Tilt the camera to a certain position (degrees)\n");
-					printf("\n");
-
-					printf("CR subaddr\n");
-					printf("  Read from a camera subaddress\n");
-					printf("\n");
-
-					printf("SNAPSHOT\n");
-					printf("  Get a new frame from the camera\n");
-					printf("\n");
-
-					printf("TRACK\n");
-					printf("  Start camera tracking\n");
-					printf("  (Prevents further input)\n");
-					printf("\n");
-
-					printf("CAMFEED\n");
-					printf("  Start a continuous camera feed\n");
-					printf("  (Prevents further input)\n");
-					printf("\n");
-
-					printf("RESET\n");
-					printf("  Reset the camera\n");
-					printf("\n");
-
-					printf("HELP\n");
-					printf("  Show these commands\n");
-					printf("\n");
-
-				// Invalid input
-				} else {
-					printf("ERROR: Invalid command\n");
-				}
-				break;
-
-			// Invalid input
-			default:
-				printf("ERROR: Invalid command\n");
-				break;
-			}
-
-		// Invalid input
-		} else {
-			printf("ERROR: Invalid command\n");
-		}
-	}
+	Scheduler::run(tasks, sizeof(tasks)/sizeof(tasks[0]));
 
 	return 0;
 }
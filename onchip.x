@@ -0,0 +1,23 @@
+/*
+ * FILENAME:	onchip.x
+ * AUTHOR:		Josh Trzebiatowski <trzebiatowskj@msoe.edu>
+ * DATE:		October 19, 2026
+ *
+ * Linker script fragment, read after the BSP linker script by adding it
+ * to the application link (APP_LDFLAGS += -T onchip.x). Places the objects
+ * marked ONCHIP (Onchip.h) in the 512 bytes of ONCHIP_MEMORY2_0 after
+ * the VGA frame. The section is loaded with the rest of the image by
+ * nios2-download, so it needs no copy at startup.
+ */
+
+SECTIONS
+{
+	.onchip_spare 0x00801E00 : AT(0x00801E00)
+	{
+		PROVIDE(__onchip_spare_start = ABSOLUTE(.));
+		*(.onchip_spare .onchip_spare.*)
+		PROVIDE(__onchip_spare_end = ABSOLUTE(.));
+	}
+}
+
+ASSERT(__onchip_spare_end <= 0x00802000, "ONCHIP objects overflow the space after the VGA frame")